@@ -0,0 +1,121 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include "Wavetable.h"
+
+// BlendedFrameCache - One voice oscillator's morphed frame (two frames lerped at the position),
+// shared by all of its unison oscillators. While the position holds still, reads come from this
+// single precomputed frame instead of two table frames, halving memory traffic per sample.
+// Mip levels are blended lazily, the first time a unison oscillator asks for them.
+class BlendedFrameCache
+{
+public:
+    BlendedFrameCache()
+    {
+        // Room for every mip level of the longest frame length (allocated here, never on the audio thread)
+        size_t totalSamples = 0;
+        for (int level = 0; level < Wavetable::numMipLevels; ++level)
+        {
+            levelOffsets[static_cast<size_t>(level)] = totalSamples;
+            totalSamples += static_cast<size_t>(Wavetable::getMipFrameLength(level));
+        }
+
+        samples.assign(totalSamples, 0.0f);
+    }
+
+    // Call once per render block with the table and position the oscillators will use
+    // The cache is only used when both are unchanged since the previous block - while the
+    // position is moving, rebuilding every block would cost more than reading two frames.
+    // Tables are compared by id, not address: a new table may reuse a freed table's memory.
+    void update(const Wavetable::Table* table, float position)
+    {
+        const uint64_t tableId = getTableId(table);
+
+        if (tableId != currentTableId || position != currentPosition)
+        {
+            currentTableId = tableId;
+            currentPosition = position;
+            validLevels = 0;
+            stable = false;
+            return;
+        }
+
+        stable = true;
+    }
+
+    // Blended frame for a mip level, or nullptr if the oscillator should read the table directly
+    // (position moving, or a table/position other than the one the cache was updated with)
+    const float* getFrame(const Wavetable::Table* table, float position, int level)
+    {
+        if (!stable || table == nullptr || table->getId() != currentTableId || position != currentPosition)
+            return nullptr;
+
+        const auto levelBit = static_cast<uint32_t>(1u << level);
+        if ((validLevels & levelBit) == 0)
+        {
+            buildLevel(*table, level);
+            validLevels |= levelBit;
+        }
+
+        return samples.data() + levelOffsets[static_cast<size_t>(level)];
+    }
+
+    void reset()
+    {
+        currentTableId = 0;
+        currentPosition = -1.0f;
+        validLevels = 0;
+        stable = false;
+    }
+
+private:
+    std::vector<float> samples; // Every mip level's blended frame, level after level
+    std::array<size_t, Wavetable::numMipLevels> levelOffsets;
+
+    uint64_t currentTableId = 0; // Wavetable::Table::getId() of the cached table (0 = none)
+    float currentPosition = -1.0f;
+    uint32_t validLevels = 0; // Bit per mip level already blended for the current key
+    bool stable = false;
+
+    static uint64_t getTableId(const Wavetable::Table* table) noexcept
+    {
+        return table != nullptr ? table->getId() : 0;
+    }
+
+    // Blend the two frames around the position (same math as WavetableOscillator::readTable)
+    void buildLevel(const Wavetable::Table& table, int level)
+    {
+        const int lastFrame = table.getNumFrames() - 1;
+        float frameIndexFloat = currentPosition * lastFrame;
+        int frame1 = static_cast<int>(frameIndexFloat);
+        int frame2 = std::min(frame1 + 1, lastFrame);
+        float frameFrac = frameIndexFloat - frame1;
+
+        const int length = table.getFrameLength(level);
+        float* dest = samples.data() + levelOffsets[static_cast<size_t>(level)];
+
+        if (table.getFormat() == Wavetable::SampleFormat::Int16)
+        {
+            const int16_t* data1 = table.getCompactFrame(level, frame1);
+            const int16_t* data2 = table.getCompactFrame(level, frame2);
+            const float scale = table.getCompactScale();
+
+            for (int i = 0; i < length; ++i)
+            {
+                float sample1 = static_cast<float>(data1[i]) * scale;
+                float sample2 = static_cast<float>(data2[i]) * scale;
+                dest[i] = sample1 + frameFrac * (sample2 - sample1);
+            }
+        }
+        else
+        {
+            const float* data1 = table.getFrame(level, frame1);
+            const float* data2 = table.getFrame(level, frame2);
+
+            for (int i = 0; i < length; ++i)
+                dest[i] = data1[i] + frameFrac * (data2[i] - data1[i]);
+        }
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// FastMath.h - Cheap approximations for control-rate DSP math
+// Accurate enough for pitch and cutoff calculations, several times faster than the std:: versions
+namespace FastMath
+{
+    // 2^x via exponent bit construction plus a polynomial for the fractional part
+    // Fraction is kept in [-0.5, 0.5], max relative error ~3e-6 (0.005 cents)
+    inline float exp2(float x)
+    {
+        x = juce::jlimit(-126.0f, 126.0f, x);
+
+        float whole = std::nearbyint(x);
+        float f = x - whole;
+
+        // Taylor series of 2^f = e^(f·ln2) up to 5th order
+        float p = 1.0f + f * (0.693147181f
+                + f * (0.240226507f
+                + f * (0.0555041087f
+                + f * (0.00961812911f
+                + f * 0.00133335581f))));
+
+        // Scale by 2^whole by building the float exponent directly
+        int32_t bits = (static_cast<int32_t>(whole) + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+
+        return p * scale;
+    }
+
+    // tan(pi * x) for x in [0, 0.5), e.g. a filter's tan(pi * fc / fs) prewarp
+    // [7/6] Padé approximant on [0, pi/4] (~1e-13 there, so float rounding dominates), reflected
+    // (tan = 1 / tan(pi/2 - angle)) above; max relative error ~3e-7 below 0.49
+    inline float tanPi(float x)
+    {
+        auto tanQuarter = [] (float angle)
+        {
+            float a2 = angle * angle;
+            return angle * (135135.0f + a2 * (-17325.0f + a2 * (378.0f - a2)))
+                 / (135135.0f + a2 * (-62370.0f + a2 * (3150.0f - a2 * 28.0f)));
+        };
+
+        constexpr float pi = juce::MathConstants<float>::pi;
+
+        if (x <= 0.25f)
+            return tanQuarter(pi * x);
+
+        return 1.0f / tanQuarter(pi * (0.5f - x));
+    }
+
+    // tanh(x) as a [7/6] Lambert continued-fraction approximant, for saturation
+    // Input clamped where the approximant reaches ±1; max absolute error ~1e-4
+    inline float tanh(float x)
+    {
+        x = juce::jlimit(-4.97f, 4.97f, x);
+        float x2 = x * x;
+        float y = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)))
+                / (135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f)));
+        return juce::jlimit(-1.0f, 1.0f, y);
+    }
+
+    // log(cosh(x)), the antiderivative of tanh (antialiased saturation)
+    // |x| - ln2 + log1p(e^(-2|x|)), with log1p(u) = 2*atanh(u / (2 + u)) as a 5-term odd series;
+    // max absolute error ~2e-6, and the error is smooth, so differences over close inputs stay accurate
+    inline float logCosh(float x)
+    {
+        const float ax = std::abs(x);
+        const float u = exp2(-2.885390082f * ax); // e^(-2|x|), -2 * log2(e)
+        const float s = u / (2.0f + u);           // 0 to 1/3
+        const float s2 = s * s;
+        const float log1pU = 2.0f * s * (1.0f + s2 * (0.333333333f + s2 * (0.2f + s2 * (0.142857143f + s2 * 0.111111111f))));
+        return ax - 0.693147181f + log1pU; // ln 2
+    }
+}
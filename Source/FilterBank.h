@@ -1,23 +1,49 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "StereoSVF.h"
+#include "StereoLadder.h"
+#include "FastMath.h"
 
 // FilterBank - Phase 3.3: Multi-mode filter with envelope modulation
-// Supports 5 filter types: LP 24dB, LP 12dB, HP 24dB, BP 12dB, Notch
+// Supports 6 filter types: LP 24dB, LP 12dB, HP 24dB, BP 12dB, Notch, Ladder 24dB
+// Stereo: L and R share one envelope step and coefficient update per sample (see StereoSVF)
+// One SVF core serves every SVF type (the 24dB types cascade two stages inside it): only the
+// selected type's coefficients are computed, and switching between SVF types keeps the filter
+// state, so the change is click-free. The ladder is a separate core, used only for its type.
+// Cutoff (envelope + keytrack) is worked out at control rate; the SVF ramps g in between
 class FilterBank
 {
 public:
+    static constexpr int controlInterval = 32; // Samples between cutoff updates (as PitchEngine)
+
     FilterBank()
     {
         // Set default filter envelope parameters
         filterEnvelope.setSampleRate(44100.0);
         filterEnvelope.setParameters({0.01f, 0.3f, 0.5f, 0.5f}); // Default ADSR
+
+        setFilterType(filterType); // Configure the SVF core for the default type
     }
 
-    // Set filter type (0=LP24, 1=LP12, 2=HP24, 3=BP12, 4=Notch)
+    // Set filter type (0=LP24, 1=LP12, 2=HP24, 3=BP12, 4=Notch, 5=Ladder)
     void setFilterType(int typeIndex)
     {
-        filterType = juce::jlimit(0, 4, typeIndex);
+        typeIndex = juce::jlimit(0, 5, typeIndex);
+
+        // Moving between the SVF and the ladder: start the other core clean, with its
+        // coefficients set on the next sample (no ramp from stale values)
+        if ((typeIndex == ladderType) != (filterType == ladderType))
+        {
+            filter.reset();
+            ladder.reset();
+            samplesUntilControlUpdate = 0;
+            coefficientsValid = false;
+        }
+
+        filterType = typeIndex;
+        filter.setType(getCoreType(filterType));
+        filter.setCascaded(filterType == 0 || filterType == 2); // LP 24dB, HP 24dB
     }
 
     // Set base cutoff frequency (20Hz to 20kHz)
@@ -33,11 +59,16 @@ public:
         resonance = 0.5f + (res / 100.0f) * 9.5f;
     }
 
-    // Set drive amount (0-100% → gain 1.0x to 10.0x)
+    // Set drive amount (0-100% → gain 1.0x to 10.0x, 0% = no saturation)
     void setDrive(float drv)
     {
         // Map 0-100% to gain 1.0-10.0
-        drive = 1.0f + (drv / 100.0f) * 9.0f;
+        float newDrive = 1.0f + (drv / 100.0f) * 9.0f;
+        if (newDrive == drive)
+            return;
+
+        drive = newDrive;
+        driveNormalize = 1.0f / std::tanh(drive); // Once per change, not per sample
     }
 
     // Set envelope depth (-100% to +100%)
@@ -76,145 +107,184 @@ public:
         sampleRate = sr;
         filterEnvelope.setSampleRate(sampleRate);
 
-        // Prepare DSP filter
-        juce::dsp::ProcessSpec spec;
-        spec.sampleRate = sampleRate;
-        spec.maximumBlockSize = 512;
-        spec.numChannels = 1; // Mono filter (per voice)
-
-        // Initialize all filter instances
-        filterLP24.prepare(spec);
-        filterLP12.prepare(spec);
-        filterHP24.prepare(spec);
-        filterBP12.prepare(spec);
-        filterNotch.prepare(spec);
-
-        filterLP24.reset();
-        filterLP12.reset();
-        filterHP24.reset();
-        filterBP12.reset();
-        filterNotch.reset();
+        // Initialize the filter cores (stereo per voice, prepare() also resets state)
+        filter.prepare(sampleRate);
+        ladder.prepare(sampleRate);
     }
 
-    // Process a single sample (mono)
-    float processSample(float inputSample, int midiNote)
+    // Process a single stereo sample pair in place
+    void processSampleStereo(float& left, float& right, int midiNote)
     {
-        // Apply pre-filter drive (saturation)
-        float drivenSample = std::tanh(inputSample * drive) / std::tanh(drive);
-
-        // Calculate modulated cutoff frequency
-        float envValue = filterEnvelope.getNextSample(); // 0.0 to 1.0
-        float envModulation = envValue * (envelopeDepth / 100.0f); // -1.0 to +1.0
-
-        // Calculate keytrack modulation
-        // Keytrack: cutoff follows MIDI note pitch (0% = fixed, 100% = 1:1 tracking)
-        // Formula: cutoff × 2^(keytrackAmount × (note - 60) / 12)
-        float keytrackMod = std::pow(2.0f, keytrackAmount * (midiNote - 60) / 12.0f);
-
-        // Combine base cutoff + envelope modulation + keytrack
-        // Envelope depth controls ±4 octaves modulation
-        float modulatedCutoff = baseCutoff * std::pow(2.0f, envModulation * 4.0f) * keytrackMod;
-
-        // Clamp to valid range (20Hz to Nyquist)
-        float nyquist = static_cast<float>(sampleRate) * 0.5f;
-        modulatedCutoff = juce::jlimit(20.0f, nyquist - 100.0f, modulatedCutoff);
-
-        // Update filter coefficients based on type
-        updateFilterCoefficients(modulatedCutoff);
-
-        // Process sample through selected filter
-        float filteredSample = 0.0f;
-
-        switch (filterType)
+        // Apply pre-filter drive (saturation); at 0% drive the signal passes untouched
+        if (drive >= antialiasedDrive)
         {
-            case 0: // LP 24dB
-                filteredSample = filterLP24.processSample(0, drivenSample);
-                break;
-
-            case 1: // LP 12dB
-                filteredSample = filterLP12.processSample(0, drivenSample);
-                break;
-
-            case 2: // HP 24dB
-                filteredSample = filterHP24.processSample(0, drivenSample);
-                break;
+            // Coming from the other paths, the previous input is stale: start the segment here
+            if (!saturatorsPrimed)
+            {
+                saturatorLeft.restart(left * drive);
+                saturatorRight.restart(right * drive);
+                saturatorsPrimed = true;
+            }
+
+            left = saturatorLeft.process(left * drive) * driveNormalize;
+            right = saturatorRight.process(right * drive) * driveNormalize;
+        }
+        else
+        {
+            saturatorsPrimed = false;
 
-            case 3: // BP 12dB
-                filteredSample = filterBP12.processSample(0, drivenSample);
-                break;
+            if (drive > 1.0f)
+            {
+                left = FastMath::tanh(left * drive) * driveNormalize;
+                right = FastMath::tanh(right * drive) * driveNormalize;
+            }
+        }
 
-            case 4: // Notch
-                filteredSample = filterNotch.processSample(0, drivenSample);
-                break;
+        // Envelope advances once per stereo sample; the cutoff follows it at control rate
+        float envValue = filterEnvelope.getNextSample(); // 0.0 to 1.0
 
-            default:
-                filteredSample = drivenSample; // Bypass
+        if (--samplesUntilControlUpdate <= 0)
+        {
+            // First update after a reset jumps straight to the cutoff, later ones ramp to it
+            updateFilterCoefficients(getModulatedCutoff(envValue, midiNote), coefficientsValid ? controlInterval : 0);
+            coefficientsValid = true;
+            samplesUntilControlUpdate = controlInterval;
         }
 
-        return filteredSample;
+        if (filterType == ladderType)
+            ladder.processStereo(left, right);
+        else
+            filter.processStereo(left, right);
     }
 
     // Reset filter state
     void reset()
     {
-        filterLP24.reset();
-        filterLP12.reset();
-        filterHP24.reset();
-        filterBP12.reset();
-        filterNotch.reset();
+        filter.reset();
+        ladder.reset();
         filterEnvelope.reset();
+        saturatorsPrimed = false;
+        samplesUntilControlUpdate = 0;
+        coefficientsValid = false;
     }
 
 private:
-    int filterType = 0; // 0=LP24, 1=LP12, 2=HP24, 3=BP12, 4=Notch
+    static constexpr int ladderType = 5;
+
+    int filterType = 0; // 0=LP24, 1=LP12, 2=HP24, 3=BP12, 4=Notch, 5=Ladder
     float baseCutoff = 8000.0f; // Base cutoff frequency (Hz)
     float resonance = 0.5f; // Q factor
     float drive = 1.0f; // Pre-filter gain
+    float driveNormalize = 1.0f / std::tanh(1.0f); // 1 / tanh(drive): full scale stays full scale
+
+    // From this drive gain up (~33%), saturation uses first-order antiderivative antialiasing:
+    // hard driving makes harmonics far above Nyquist, which plain tanh would fold back
+    static constexpr float antialiasedDrive = 4.0f;
+
+    // tanh averaged over the segment from the previous input to x (ADAA), one per channel:
+    // (F(x) - F(previous)) / (x - previous), with F(x) = log(cosh(x)) the antiderivative.
+    // F(previous) is kept from the last sample, so each sample evaluates F once.
+    struct AntialiasedSaturator
+    {
+        float previous = 0.0f;
+        float previousF = 0.0f; // FastMath::logCosh(previous)
+
+        // Start from input x, as if the previous sample had been x (next process(x) gives tanh(x))
+        void restart(float x)
+        {
+            previous = x;
+            previousF = FastMath::logCosh(x);
+        }
+
+        float process(float x)
+        {
+            const float delta = x - previous;
+            const float f = FastMath::logCosh(x);
+
+            // Ill-conditioned when the inputs are close: tanh of the midpoint instead
+            const float y = std::abs(delta) < 1.0e-3f ? FastMath::tanh(0.5f * (x + previous))
+                                                      : (f - previousF) / delta;
+
+            previous = x;
+            previousF = f;
+            return y;
+        }
+    };
+
+    AntialiasedSaturator saturatorLeft;
+    AntialiasedSaturator saturatorRight;
+    bool saturatorsPrimed = false; // False until the antialiased path has run since the last reset or other path
     float envelopeDepth = 0.0f; // Envelope modulation depth (-100 to +100)
     float keytrackAmount = 0.0f; // Keytrack amount (0.0 to 1.0)
     double sampleRate = 44100.0;
 
+    // Control-rate cutoff updates
+    int samplesUntilControlUpdate = 0;
+    bool coefficientsValid = false; // False until the first update after a reset (no ramp)
+
     // Filter envelope (ADSR)
     juce::ADSR filterEnvelope;
 
-    // Filter instances (JUCE DSP StateVariableTPTFilter)
-    using Filter = juce::dsp::StateVariableTPTFilter<float>;
-
-    Filter filterLP24; // Lowpass 24dB/oct
-    Filter filterLP12; // Lowpass 12dB/oct
-    Filter filterHP24; // Highpass 24dB/oct
-    Filter filterBP12; // Bandpass 12dB/oct
-    Filter filterNotch; // Notch filter
-
-    // Update filter coefficients based on current parameters
-    void updateFilterCoefficients(float cutoff)
-    {
-        // LP 24dB: Two cascaded LP filters (24dB/oct = 4-pole)
-        filterLP24.setCutoffFrequency(cutoff);
-        filterLP24.setResonance(resonance);
-        filterLP24.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-
-        // LP 12dB: Single LP filter (12dB/oct = 2-pole)
-        filterLP12.setCutoffFrequency(cutoff);
-        filterLP12.setResonance(0.707f); // Butterworth response
-        filterLP12.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-
-        // HP 24dB: Two cascaded HP filters
-        filterHP24.setCutoffFrequency(cutoff);
-        filterHP24.setResonance(resonance);
-        filterHP24.setType(juce::dsp::StateVariableTPTFilterType::highpass);
-
-        // BP 12dB: Bandpass filter
-        filterBP12.setCutoffFrequency(cutoff);
-        filterBP12.setResonance(resonance);
-        filterBP12.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-
-        // Notch: Band-reject filter
-        filterNotch.setCutoffFrequency(cutoff);
-        filterNotch.setResonance(resonance);
-        // JUCE StateVariableTPTFilter doesn't have direct notch type
-        // We'll use bandpass and invert (output = input - bandpass)
-        // For now, use lowpass (will implement proper notch if needed)
-        filterNotch.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    // Filter cores: stereo TPT state variable filter (all SVF types) and 4-pole ladder
+    using Filter = StereoSVF;
+
+    Filter filter;
+    StereoLadder ladder;
+
+    // Q of the two stages of a 4th-order Butterworth: resonance 0% gives a flat 24dB response,
+    // and the resonance raises the second stage's Q from there
+    static constexpr float butterworthQ1 = 0.5412f;
+    static constexpr float butterworthQ2 = 1.3066f;
+
+    // Core response for a filter type (0=LP24, 1=LP12, 2=HP24, 3=BP12, 4=Notch)
+    static StereoSVF::Type getCoreType(int type)
+    {
+        switch (type)
+        {
+            case 2:  return StereoSVF::Type::highpass;
+            case 3:  return StereoSVF::Type::bandpass;
+            case 4:  return StereoSVF::Type::notch;
+            default: return StereoSVF::Type::lowpass;
+        }
+    }
+
+    // Cutoff with envelope and keytrack modulation, clamped to 20Hz to just below Nyquist
+    float getModulatedCutoff(float envValue, int midiNote) const
+    {
+        // Envelope depth controls ±4 octaves modulation
+        float envOctaves = envValue * (envelopeDepth / 100.0f) * 4.0f;
+
+        // Keytrack: cutoff follows MIDI note pitch (0% = fixed, 100% = 1:1 tracking)
+        float keytrackOctaves = keytrackAmount * static_cast<float>(midiNote - 60) / 12.0f;
+
+        // cutoff × 2^(env octaves) × 2^(keytrack octaves), as a single exp2
+        float modulatedCutoff = baseCutoff * FastMath::exp2(envOctaves + keytrackOctaves);
+
+        float nyquist = static_cast<float>(sampleRate) * 0.5f;
+        return juce::jlimit(20.0f, nyquist - 100.0f, modulatedCutoff);
+    }
+
+    // Update the active core's coefficients for the selected type only
+    void updateFilterCoefficients(float cutoff, int rampSamples)
+    {
+        switch (filterType)
+        {
+            case 0: // LP 24dB
+            case 2: // HP 24dB
+                filter.setParameterTargets(cutoff, butterworthQ1, resonance - 0.5f + butterworthQ2, rampSamples);
+                break;
+
+            case 1: // LP 12dB: fixed Butterworth response
+                filter.setParameterTargets(cutoff, 0.707f, 0.707f, rampSamples);
+                break;
+
+            case ladderType: // Q 0.5-10 → feedback 0 to just below self-oscillation
+                ladder.setParameterTargets(cutoff, (resonance - 0.5f) / 9.5f * StereoLadder::maxFeedback, rampSamples);
+                break;
+
+            default: // BP 12dB, Notch
+                filter.setParameterTargets(cutoff, resonance, resonance, rampSamples);
+                break;
+        }
     }
 };
@@ -1,10 +1,12 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
 #include <cmath>
+#include <cstdint>
 
 // LFO.h - Phase 3.6: LFO Generation
 // Low-frequency oscillator with 5 waveform shapes
 // NOTE: v1.0 has NO routing (no mod matrix) - LFOs generate signals but don't modulate anything
+// Phase is a uint32 fraction of a cycle (wraps for free on overflow, no drift)
 class LFO
 {
 public:
@@ -30,7 +32,7 @@ public:
 
     void reset()
     {
-        phase = 0.0f;
+        phase = 0;
         lastSampleAndHoldValue = 0.0f;
     }
 
@@ -58,47 +60,16 @@ public:
     // Get next LFO sample (bipolar output: -1.0 to +1.0)
     float getNextSample()
     {
-        float output = 0.0f;
-
-        switch (currentShape)
-        {
-            case Sine:
-                output = std::sin(phase);
-                break;
-
-            case Triangle:
-                // Triangle wave: piecewise linear
-                output = (2.0f / juce::MathConstants<float>::pi) * std::asin(std::sin(phase));
-                break;
-
-            case Saw:
-                // Saw wave: ramp up from -1 to +1
-                output = (phase / (2.0f * juce::MathConstants<float>::pi)) * 2.0f - 1.0f;
-                break;
-
-            case Square:
-                // Square wave: -1 or +1
-                output = phase < juce::MathConstants<float>::pi ? 1.0f : -1.0f;
-                break;
+        // Sample & Hold: random value held for entire cycle
+        // Update random value when phase wraps
+        if (currentShape == SampleAndHold && phase < phaseIncrement) // Wrapped past the end of the cycle
+            lastSampleAndHoldValue = randomGenerator.nextFloat() * 2.0f - 1.0f; // -1.0 to +1.0
 
-            case SampleAndHold:
-                // Sample & Hold: random value held for entire cycle
-                // Update random value when phase wraps
-                if (phase < phaseIncrement) // Wrapped from 2π to 0
-                {
-                    lastSampleAndHoldValue = randomGenerator.nextFloat() * 2.0f - 1.0f; // -1.0 to +1.0
-                }
-                output = lastSampleAndHoldValue;
-                break;
-        }
+        float output = getCurrentValue();
 
-        // Advance phase
+        // Advance phase (wraps on overflow)
         phase += phaseIncrement;
 
-        // Wrap phase to [0, 2π)
-        if (phase >= 2.0f * juce::MathConstants<float>::pi)
-            phase -= 2.0f * juce::MathConstants<float>::pi;
-
         return output;
     }
 
@@ -106,23 +77,27 @@ public:
     float getCurrentValue() const
     {
         float output = 0.0f;
+        const float cyclePosition = static_cast<float>(phase) * (1.0f / 4294967296.0f); // 0.0 to 1.0
 
         switch (currentShape)
         {
             case Sine:
-                output = std::sin(phase);
+                output = std::sin(cyclePosition * juce::MathConstants<float>::twoPi);
                 break;
 
             case Triangle:
-                output = (2.0f / juce::MathConstants<float>::pi) * std::asin(std::sin(phase));
+                // Triangle wave: piecewise linear
+                output = (2.0f / juce::MathConstants<float>::pi) * std::asin(std::sin(cyclePosition * juce::MathConstants<float>::twoPi));
                 break;
 
             case Saw:
-                output = (phase / (2.0f * juce::MathConstants<float>::pi)) * 2.0f - 1.0f;
+                // Saw wave: ramp up from -1 to +1
+                output = cyclePosition * 2.0f - 1.0f;
                 break;
 
             case Square:
-                output = phase < juce::MathConstants<float>::pi ? 1.0f : -1.0f;
+                // Square wave: -1 or +1 (top phase bit: second half of the cycle)
+                output = phase < 0x80000000u ? 1.0f : -1.0f;
                 break;
 
             case SampleAndHold:
@@ -138,8 +113,8 @@ private:
     float rate = 1.0f; // Hz
     bool tempoSyncEnabled = false; // RESERVED for v1.1 (currently inactive)
 
-    float phase = 0.0f; // Current phase (0 to 2π)
-    float phaseIncrement = 0.0f; // Phase increment per sample
+    uint32_t phase = 0;          // Current phase (2^32 = one cycle)
+    uint32_t phaseIncrement = 0; // Phase units per sample
     double sampleRate = 44100.0;
 
     // Sample & Hold state
@@ -149,7 +124,7 @@ private:
     // Update phase increment based on rate and sample rate
     void updatePhaseIncrement()
     {
-        // phase_increment = (2π × frequency) / sampleRate
-        phaseIncrement = (2.0f * juce::MathConstants<float>::pi * rate) / static_cast<float>(sampleRate);
+        // phase_increment = 2^32 × frequency / sampleRate (rate is at most 100 Hz, far below one cycle per sample)
+        phaseIncrement = static_cast<uint32_t>(4294967296.0 * rate / sampleRate);
     }
 };
@@ -0,0 +1,146 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+// MinBlepTable - Band-limited step residual for removing aliasing from hard discontinuities
+// A minimum-phase band-limited step (minBLEP) rises from 0 to 1 without pre-ringing, so a
+// correction can start exactly at a discontinuity and only touches samples after it.
+// The table holds the residual (minBLEP - ideal step), oversampled for sub-sample placement.
+// Built once, on first use (call getInstance() off the audio thread, e.g. in a constructor).
+class MinBlepTable
+{
+public:
+    static constexpr int zeroCrossings = 8;               // Sinc lobes either side of the centre
+    static constexpr int length = 2 * zeroCrossings;      // Residual length in output samples
+    static constexpr int oversampling = 64;               // Table points per output sample
+
+    static const MinBlepTable& getInstance()
+    {
+        static const MinBlepTable table; // Function-local static: thread-safe construction
+        return table;
+    }
+
+    // Residual at time t samples after the step (0 <= t < length), linearly interpolated
+    float getResidual(float t) const
+    {
+        const float index = t * oversampling;
+        const int i = static_cast<int>(index);
+        const float frac = index - static_cast<float>(i);
+        return residual[static_cast<size_t>(i)] + frac * (residual[static_cast<size_t>(i) + 1] - residual[static_cast<size_t>(i)]);
+    }
+
+private:
+    std::vector<float> residual; // length * oversampling points, plus zero guard points
+
+    MinBlepTable()
+    {
+        constexpr int impulseLength = length * oversampling;
+        constexpr int fftOrder = 12; // 4096 points: 4x the impulse, so the cepstrum barely aliases
+        constexpr int fftSize = 1 << fftOrder;
+        static_assert(fftSize >= 4 * impulseLength, "FFT too short for the impulse");
+
+        // 1. Blackman-windowed sinc, band-limited to the output Nyquist frequency
+        std::vector<float> buffer(static_cast<size_t>(fftSize) * 2, 0.0f);
+        for (int i = 0; i < impulseLength; ++i)
+        {
+            const double t = (i - impulseLength * 0.5) / oversampling; // In output samples
+            const double sinc = (t == 0.0) ? 1.0 : std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+            const double w = static_cast<double>(i) / impulseLength;
+            const double window = 0.42 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * w)
+                                + 0.08 * std::cos(2.0 * juce::MathConstants<double>::twoPi * w);
+            buffer[static_cast<size_t>(i)] = static_cast<float>(sinc * window);
+        }
+
+        // 2. Minimum phase via the real cepstrum: log magnitude → cepstrum → fold → exp
+        juce::dsp::FFT fft(fftOrder);
+        fft.performRealOnlyForwardTransform(buffer.data());
+
+        for (int bin = 0; bin <= fftSize / 2; ++bin)
+        {
+            const auto b = static_cast<size_t>(bin);
+            const float magnitude = std::hypot(buffer[2 * b], buffer[2 * b + 1]);
+            buffer[2 * b] = std::log(juce::jmax(magnitude, 1.0e-9f));
+            buffer[2 * b + 1] = 0.0f;
+        }
+
+        fft.performRealOnlyInverseTransform(buffer.data()); // Real cepstrum (even sequence)
+
+        // Fold the anti-causal half onto the causal half
+        for (int i = 1; i < fftSize / 2; ++i)
+            buffer[static_cast<size_t>(i)] *= 2.0f;
+        std::fill(buffer.begin() + fftSize / 2 + 1, buffer.end(), 0.0f);
+
+        fft.performRealOnlyForwardTransform(buffer.data());
+
+        for (int bin = 0; bin <= fftSize / 2; ++bin)
+        {
+            const auto b = static_cast<size_t>(bin);
+            const auto value = std::exp(std::complex<float>(buffer[2 * b], buffer[2 * b + 1]));
+            buffer[2 * b] = value.real();
+            buffer[2 * b + 1] = value.imag();
+        }
+
+        fft.performRealOnlyInverseTransform(buffer.data()); // Minimum-phase impulse
+
+        // 3. Integrate into a step, normalise it to end at exactly 1, subtract the ideal step
+        residual.assign(static_cast<size_t>(impulseLength) + 2, 0.0f); // Guards: t may reach length
+
+        double sum = 0.0;
+        for (int i = 0; i < impulseLength; ++i)
+            sum += buffer[static_cast<size_t>(i)];
+
+        double step = 0.0;
+        for (int i = 0; i < impulseLength; ++i)
+        {
+            step += buffer[static_cast<size_t>(i)];
+            residual[static_cast<size_t>(i)] = static_cast<float>(step / sum - 1.0);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(MinBlepTable)
+};
+
+// MinBlepBuffer - One oscillator's pending step corrections, mixed into its next output samples
+// addStep() spreads a residual over the following MinBlepTable::length samples;
+// getNextCorrection() pops the correction for the sample being output.
+class MinBlepBuffer
+{
+public:
+    MinBlepBuffer() : table(&MinBlepTable::getInstance()) {}
+
+    // Correction to add to the current output sample (then moves on to the next sample)
+    float getNextCorrection()
+    {
+        const float correction = corrections[static_cast<size_t>(readIndex)];
+        corrections[static_cast<size_t>(readIndex)] = 0.0f;
+        readIndex = (readIndex + 1) & mask;
+        return correction;
+    }
+
+    // A step of height (value after - value before) happened delay samples (0 to 1) before
+    // the next output sample
+    void addStep(float delay, float height)
+    {
+        for (int k = 0; k < MinBlepTable::length; ++k)
+            corrections[static_cast<size_t>((readIndex + k) & mask)] += height * table->getResidual(delay + static_cast<float>(k));
+    }
+
+    void clear()
+    {
+        corrections.fill(0.0f);
+        readIndex = 0;
+    }
+
+private:
+    static constexpr int size = 32; // Power of two, at least MinBlepTable::length
+    static constexpr int mask = size - 1;
+    static_assert(size >= MinBlepTable::length, "Buffer shorter than the residual");
+
+    const MinBlepTable* table;
+    std::array<float, size> corrections {};
+    int readIndex = 0;
+};
@@ -50,6 +50,13 @@ public:
         return output;
     }
 
+    // Render numSamples into out
+    void renderBlock(float* out, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = getNextSample();
+    }
+
     // Reset oscillator state
     void reset()
     {
@@ -0,0 +1,117 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include "FastMath.h"
+#include "UnisonTables.h"
+
+// PitchEngine - Per-voice control-rate pitch: glide + pitch bend + tuning + unison detune
+// Pitch is tracked in semitones (fractional MIDI note) and only converted to oscillator
+// phase increments once per control interval; oscillators ramp linearly between updates.
+class PitchEngine
+{
+public:
+    static constexpr int controlInterval = 32; // Samples between pitch updates
+    static constexpr float pitchBendRangeSemitones = 2.0f; // ±2 semitones (standard MIDI range)
+
+    void setSampleRate(double sr)
+    {
+        sampleRate = sr;
+        updateGlideCoefficient();
+    }
+
+    // Start a note, gliding from the previous note when glide is enabled
+    void noteOn(int noteNumber, float glideTimeSeconds)
+    {
+        targetNote = static_cast<float>(noteNumber);
+        glideTime = glideTimeSeconds;
+
+        if (glideTimeSeconds > 0.0f && hasPlayed)
+        {
+            // Glide from current pitch to target pitch (exponential in the pitch domain)
+            glideActive = true;
+            updateGlideCoefficient();
+        }
+        else
+        {
+            // No glide: instant pitch change
+            currentNote = targetNote;
+            glideActive = false;
+        }
+
+        hasPlayed = true;
+    }
+
+    // Set pitch bend (-1 to +1, scaled by the bend range)
+    void setPitchBend(float bend)
+    {
+        pitchBend = juce::jlimit(-1.0f, 1.0f, bend) * pitchBendRangeSemitones;
+    }
+
+    // Advance glide by numSamples; the pitch returned by getIncrement() is then the target
+    // for the end of that span, so oscillators can ramp towards it over numSamples
+    void advance(int numSamples)
+    {
+        if (!glideActive)
+            return;
+
+        // One control step of the exponential smoother covering numSamples samples
+        float coefficient = (numSamples == controlInterval)
+            ? glideCoefficient
+            : 1.0f - std::exp(-numSamples / (glideTime * static_cast<float>(sampleRate)));
+
+        currentNote += (targetNote - currentNote) * coefficient;
+
+        // Stop gliding when very close to target (~0.1% in frequency)
+        if (std::abs(targetNote - currentNote) < 0.0173f)
+        {
+            currentNote = targetNote;
+            glideActive = false;
+        }
+    }
+
+    // Phase increment for an oscillator tuned tuneSemitones from the note,
+    // where cycleLength is the phase span of one cycle (table length or 2π)
+    float getIncrement(float tuneSemitones, float cycleLength) const
+    {
+        float note = currentNote + pitchBend + tuneSemitones;
+        float freq = 440.0f * FastMath::exp2((note - 69.0f) * (1.0f / 12.0f));
+        return freq / static_cast<float>(sampleRate) * cycleLength;
+    }
+
+    // Phase increments for a full bank of unison oscillators (detune applied as frequency factors)
+    // Lanes beyond the unison count get the undetuned increment, so they are ready if the count grows
+    void getUnisonIncrements(float tuneSemitones, float cycleLength,
+                             const UnisonTables::Table& unison, float* increments) const
+    {
+        float baseIncrement = getIncrement(tuneSemitones, cycleLength);
+
+        for (int i = 0; i < UnisonTables::maxUnisonVoices; ++i)
+            increments[i] = baseIncrement * unison.detuneFactors[static_cast<size_t>(i)];
+    }
+
+    void reset()
+    {
+        currentNote = 0.0f;
+        targetNote = 0.0f;
+        pitchBend = 0.0f;
+        glideActive = false;
+        hasPlayed = false;
+    }
+
+private:
+    double sampleRate = 44100.0;
+    float currentNote = 0.0f; // Current (gliding) pitch in semitones
+    float targetNote = 0.0f;  // Pitch of the held note
+    float pitchBend = 0.0f;   // Pitch bend offset in semitones
+    float glideTime = 0.0f;   // Glide time in seconds
+    float glideCoefficient = 0.0f; // Smoothing coefficient per control interval
+    bool glideActive = false;
+    bool hasPlayed = false; // Glide only starts from a previously played note
+
+    void updateGlideCoefficient()
+    {
+        // Per-sample coeff = 1 - exp(-1 / (glideTime * sampleRate)), applied controlInterval times
+        if (glideTime > 0.0f)
+            glideCoefficient = 1.0f - std::exp(-controlInterval / (glideTime * static_cast<float>(sampleRate)));
+    }
+};
@@ -72,6 +72,8 @@ CodoxAudioProcessorEditor::CodoxAudioProcessorEditor (CodoxAudioProcessor& p)
     , unisonVoicesRelay("unison_voices")
     , unisonDetuneRelay("unison_detune")
     , glideTimeRelay("glide_time")
+    , wtInterpolationRelay("wt_interpolation")
+    , wtStorageRelay("wt_storage")
     // Effects
     , fxDistortionMixRelay("fx_distortion_mix")
     , fxChorusMixRelay("fx_chorus_mix")
@@ -103,6 +105,19 @@ CodoxAudioProcessorEditor::CodoxAudioProcessorEditor (CodoxAudioProcessor& p)
             loadPresetFromFile();
             completion({});
         })
+        // User wavetable import (args[0] = oscillator: 0 = A, 1 = B)
+        .withNativeFunction("loadWavetableFile", [this](const juce::Array<juce::var>& args, juce::WebBrowserComponent::NativeFunctionCompletion completion) {
+            if (args.size() >= 1) {
+                loadWavetableFromFile(static_cast<int>(args[0]));
+            }
+            completion({});
+        })
+        .withNativeFunction("clearUserWavetable", [this](const juce::Array<juce::var>& args, juce::WebBrowserComponent::NativeFunctionCompletion completion) {
+            if (args.size() >= 1) {
+                audioProcessor.wavetableLoader.clear(static_cast<int>(args[0]));
+            }
+            completion({});
+        })
         // v2.1: Modulation matrix route setting
         .withNativeFunction("setModRoute", [this](const juce::Array<juce::var>& args, juce::WebBrowserComponent::NativeFunctionCompletion completion) {
             if (args.size() >= 3) {
@@ -173,6 +188,8 @@ CodoxAudioProcessorEditor::CodoxAudioProcessorEditor (CodoxAudioProcessor& p)
         .withOptionsFrom(unisonVoicesRelay)
         .withOptionsFrom(unisonDetuneRelay)
         .withOptionsFrom(glideTimeRelay)
+        .withOptionsFrom(wtInterpolationRelay)
+        .withOptionsFrom(wtStorageRelay)
         .withOptionsFrom(fxDistortionMixRelay)
         .withOptionsFrom(fxChorusMixRelay)
         .withOptionsFrom(fxPhaserMixRelay)
@@ -255,6 +272,8 @@ CodoxAudioProcessorEditor::CodoxAudioProcessorEditor (CodoxAudioProcessor& p)
     , unisonVoicesAttachment(*audioProcessor.parameters.getParameter("unison_voices"), unisonVoicesRelay, nullptr)
     , unisonDetuneAttachment(*audioProcessor.parameters.getParameter("unison_detune"), unisonDetuneRelay, nullptr)
     , glideTimeAttachment(*audioProcessor.parameters.getParameter("glide_time"), glideTimeRelay, nullptr)
+    , wtInterpolationAttachment(*audioProcessor.parameters.getParameter("wt_interpolation"), wtInterpolationRelay, nullptr)
+    , wtStorageAttachment(*audioProcessor.parameters.getParameter("wt_storage"), wtStorageRelay, nullptr)
     // Effects
     , fxDistortionMixAttachment(*audioProcessor.parameters.getParameter("fx_distortion_mix"), fxDistortionMixRelay, nullptr)
     , fxChorusMixAttachment(*audioProcessor.parameters.getParameter("fx_chorus_mix"), fxChorusMixRelay, nullptr)
@@ -443,6 +462,25 @@ void CodoxAudioProcessorEditor::loadPresetFromFile()
         });
 }
 
+void CodoxAudioProcessorEditor::loadWavetableFromFile(int oscillator)
+{
+    // Create file chooser for wavetable audio files
+    auto chooser = std::make_shared<juce::FileChooser>(
+        "Load Wavetable",
+        juce::File::getSpecialLocation(juce::File::userDocumentsDirectory),
+        "*.wav;*.aif;*.aiff"
+    );
+
+    chooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+        [this, chooser, oscillator](const juce::FileChooser& fc) {
+            auto file = fc.getResult();
+            if (file != juce::File{} && file.existsAsFile()) {
+                // Decoded in the background; the oscillator switches over once it is ready
+                audioProcessor.wavetableLoader.loadFile(oscillator, file);
+            }
+        });
+}
+
 void CodoxAudioProcessorEditor::sendPresetToWebView(const juce::String& jsonData)
 {
     // Escape the JSON for JavaScript string
@@ -112,7 +112,7 @@ private:
     juce::WebSliderRelay lfo4RateRelay;
     juce::WebToggleButtonRelay lfo4SyncRelay;
 
-    // Macros + Voice (7 parameters)
+    // Macros + Voice (9 parameters)
     juce::WebSliderRelay macro1Relay;
     juce::WebSliderRelay macro2Relay;
     juce::WebSliderRelay macro3Relay;
@@ -120,6 +120,8 @@ private:
     juce::WebComboBoxRelay unisonVoicesRelay;
     juce::WebSliderRelay unisonDetuneRelay;
     juce::WebSliderRelay glideTimeRelay;
+    juce::WebComboBoxRelay wtInterpolationRelay;
+    juce::WebComboBoxRelay wtStorageRelay;
 
     // Effects (12 parameters)
     juce::WebSliderRelay fxDistortionMixRelay;
@@ -216,6 +218,8 @@ private:
     juce::WebComboBoxParameterAttachment unisonVoicesAttachment;
     juce::WebSliderParameterAttachment unisonDetuneAttachment;
     juce::WebSliderParameterAttachment glideTimeAttachment;
+    juce::WebComboBoxParameterAttachment wtInterpolationAttachment;
+    juce::WebComboBoxParameterAttachment wtStorageAttachment;
 
     // Effects
     juce::WebSliderParameterAttachment fxDistortionMixAttachment;
@@ -238,6 +242,9 @@ private:
     void savePresetToFile(const juce::String& jsonData, const juce::String& presetName);
     void loadPresetFromFile();
 
+    // Native user wavetable import (0 = Osc A, 1 = Osc B)
+    void loadWavetableFromFile(int oscillator);
+
     // Invoke JS callback with loaded preset data
     void sendPresetToWebView(const juce::String& jsonData);
 
@@ -81,11 +81,12 @@ juce::AudioProcessorValueTreeState::ParameterLayout CodoxAudioProcessor::createP
         0
     ));
 
-    // osc_a_warp_mode - Choice (0-4: Sync, Bend+, FM, AM, PWM)
+    // osc_a_warp_mode - Choice (0-6: Sync, Bend+, FM, AM, PWM, FM (B), RM (B))
+    // FM (B) and RM (B) are cross-modulation: osc B modulates osc A's phase or amplitude
     layout.add(std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID { "osc_a_warp_mode", 1 },
         "Osc A Warp Mode",
-        juce::StringArray { "Sync", "Bend+", "FM", "AM", "PWM" },
+        juce::StringArray { "Sync", "Bend+", "FM", "AM", "PWM", "FM (B)", "RM (B)" },
         0
     ));
 
@@ -223,11 +224,11 @@ juce::AudioProcessorValueTreeState::ParameterLayout CodoxAudioProcessor::createP
 
     // ==================== FILTER ====================
 
-    // filter_type - Choice (0-4: LP 24dB, LP 12dB, HP 24dB, BP 12dB, Notch)
+    // filter_type - Choice (0-5: LP 24dB, LP 12dB, HP 24dB, BP 12dB, Notch, Ladder 24dB)
     layout.add(std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID { "filter_type", 1 },
         "Filter Type",
-        juce::StringArray { "LP 24dB", "LP 12dB", "HP 24dB", "BP 12dB", "Notch" },
+        juce::StringArray { "LP 24dB", "LP 12dB", "HP 24dB", "BP 12dB", "Notch", "Ladder 24dB" },
         0
     ));
 
@@ -860,10 +861,38 @@ juce::AudioProcessorValueTreeState::ParameterLayout CodoxAudioProcessor::createP
         "ms"
     ));
 
+    // ==================== ADDED IN LATER VERSIONS ====================
+    // Appended after everything above, so hosts that address parameters by index keep their
+    // automation and mappings: new parameters always go at the end of the layout
+
+    // wt_interpolation - Choice (0-2: Linear, Cubic, Hermite) - sample interpolation within wavetable frames
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "wt_interpolation", 1 },
+        "Wavetable Interpolation",
+        juce::StringArray { "Linear", "Cubic", "Hermite" },
+        0  // Default: Linear
+    ));
+
+    // wt_storage - Choice (0-1: Float, Compact) - sample storage of built-in and user wavetables
+    // Compact (16-bit) halves table memory; switching rebuilds or maps the tables, so it isn't automatable
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "wt_storage", 1 },
+        "Wavetable Storage",
+        juce::StringArray { "Float", "Compact" },
+        0,  // Default: Float
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    ));
+
     return layout;
 }
 
 //==============================================================================
+std::atomic<int> CodoxAudioProcessor::numLiveInstances { 0 };
+
+const juce::String CodoxAudioProcessor::filterCutoffId { "filter_cutoff" };
+const juce::String CodoxAudioProcessor::oscAPositionId { "osc_a_position" };
+const juce::String CodoxAudioProcessor::oscBPositionId { "osc_b_position" };
+
 CodoxAudioProcessor::CodoxAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))  // Synth: output-only bus
@@ -875,19 +904,56 @@ CodoxAudioProcessor::CodoxAudioProcessor()
     {
         voices.push_back(std::make_unique<Voice>());
     }
+
+    tableStorage = parameters.getRawParameterValue("wt_storage");
+
+    ++numLiveInstances;
+
+    // Start preparing tables in the chosen storage format (after the host has restored state)
+    triggerAsyncUpdate();
 }
 
 CodoxAudioProcessor::~CodoxAudioProcessor()
 {
+    cancelPendingUpdate();
+
+    if (--numLiveInstances == 0)
+        Wavetable::cancelBuiltInTables();
+}
+
+Wavetable::SampleFormat CodoxAudioProcessor::getRequestedTableFormat() const noexcept
+{
+    return tableStorage->load() >= 0.5f ? Wavetable::SampleFormat::Int16 : Wavetable::SampleFormat::Float32;
+}
+
+// Message thread: prepare the built-in tables in the requested format and reload user tables in it
+void CodoxAudioProcessor::handleAsyncUpdate()
+{
+    const auto format = getRequestedTableFormat();
+    Wavetable::prepareBuiltInTables(format);
+    wavetableLoader.setFormat(format);
 }
 
 //==============================================================================
 void CodoxAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
+    // Built-in tables must be ready before the first block, or a bounce starts with silence
+    // (quick when they are cached on disk; a first run generates them here)
+    activeTableFormat = getRequestedTableFormat();
+    wavetableLoader.setFormat(activeTableFormat);
+    Wavetable::waitForBuiltInTables(activeTableFormat);
+
     // Prepare all voices
     for (auto& voice : voices)
         voice->prepareToPlay(sampleRate);
 
+    // Reserve all scratch memory up front for the voice sum plus every voice's buffers.
+    // processBlock renders in control blocks, so buffers are bounded by controlBlockSize
+    // (not samplesPerBlock, which hosts are allowed to exceed)
+    scratchArena.prepare(2 * ScratchArena::getAlignedSize(controlBlockSize)       // Voice sum L/R
+                         + 2 * ScratchArena::getAlignedSize(controlBlockSize)     // Osc A/B position lanes
+                         + numVoices * Voice::getScratchSize(controlBlockSize));  // Per-voice buffers
+
     // Phase 3.5: Prepare effects chain
     effectsChain.prepareToPlay(sampleRate, samplesPerBlock);
 
@@ -904,6 +970,9 @@ void CodoxAudioProcessor::releaseResources()
     for (auto& voice : voices)
         voice->reset();
 
+    // Audio has stopped, so tables swapped out of the user wavetable slots can go now
+    wavetableLoader.releaseRetiredTables();
+
     // Phase 3.5: Reset effects chain
     effectsChain.reset();
 
@@ -918,6 +987,25 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
 {
     juce::ScopedNoDenormals noDenormals;
 
+    // wt_storage changed: keep playing the current tables until the requested ones are ready
+    // (offline renders may block, so they wait; otherwise the message thread prepares them)
+    const auto requestedTableFormat = getRequestedTableFormat();
+    if (requestedTableFormat != activeTableFormat)
+    {
+        if (isNonRealtime())
+            Wavetable::waitForBuiltInTables(requestedTableFormat);
+
+        if (Wavetable::areBuiltInTablesReady(requestedTableFormat))
+            activeTableFormat = requestedTableFormat;
+        else
+            triggerAsyncUpdate();
+    }
+
+    // Offline renders may block: make sure no block is rendered without the built-in tables
+    // (prepareToPlay already waited; this covers a switch to offline without a new prepare)
+    if (isNonRealtime() && !Wavetable::areBuiltInTablesReady(activeTableFormat))
+        Wavetable::waitForBuiltInTables(activeTableFormat);
+
     // Clear output buffer
     buffer.clear();
 
@@ -979,6 +1067,7 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
 
     // Read unison parameters (Phase 3.4)
     auto* unison_voices = parameters.getRawParameterValue("unison_voices");
+    auto* wt_interpolation = parameters.getRawParameterValue("wt_interpolation");
     auto* unison_detune = parameters.getRawParameterValue("unison_detune");
 
     // Phase 3.6: Read LFO parameters
@@ -1163,12 +1252,20 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     effectsChain.setCompressorAttack(fx_compressor_attack->load());
     effectsChain.setCompressorRelease(fx_compressor_release->load());
 
+    // User wavetables (nullptr = built-in table), loaded once so every voice uses the same table this block
+    const auto* userTableA = wavetableLoader.getTable(0);
+    const auto* userTableB = wavetableLoader.getTable(1);
+
     // Update all voices with current parameters
     for (auto& voice : voices)
     {
         // Update envelope
         voice->updateEnvelope(attack, decay, sustain, release);
 
+        // Wavetable sample interpolation and built-in table storage (shared by Osc A and B)
+        voice->setInterpolation(static_cast<int>(wt_interpolation->load()));
+        voice->setTableFormat(activeTableFormat);
+
         // Update oscillator A
         voice->updateOscillatorA(
             static_cast<int>(oscA_wavetable->load()),
@@ -1179,7 +1276,8 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
             static_cast<int>(oscA_semitone->load()),
             static_cast<int>(oscA_fine->load()),
             static_cast<int>(oscA_warpMode->load()),
-            oscA_warpAmount->load()
+            oscA_warpAmount->load(),
+            userTableA
         );
 
         // Update oscillator B
@@ -1192,7 +1290,8 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
             static_cast<int>(oscB_semitone->load()),
             static_cast<int>(oscB_fine->load()),
             static_cast<int>(oscB_warpMode->load()),
-            oscB_warpAmount->load()
+            oscB_warpAmount->load(),
+            userTableB
         );
 
         // Update sub oscillator (Phase 3.3)
@@ -1286,6 +1385,10 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     // Update velocity modulation source (persists until next note)
     modMatrix.setSourceValue(ModSource::Velocity, currentVelocity);
 
+    // Apply pitch bend to all voices (picked up at their next control-rate pitch update)
+    for (auto& voice : voices)
+        voice->setPitchBend(currentPitchBend);
+
     // Generate audio from all active voices (Phase 3.2d - stereo with constant-power panning)
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
@@ -1315,13 +1418,20 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     modMatrix.setSourceValue(ModSource::Macro7, macro7Param->load() / 100.0f);
     modMatrix.setSourceValue(ModSource::Macro8, macro8Param->load() / 100.0f);
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    // Render in control blocks: modulation is evaluated once per block, voices render whole blocks
+    for (int blockStart = 0; blockStart < numSamples; blockStart += controlBlockSize)
     {
-        // v2.1: Update LFO modulation sources (LFOs output -1 to +1)
-        float lfo1Val = lfo1.getNextSample();
-        float lfo2Val = lfo2.getNextSample();
-        float lfo3Val = lfo3.getNextSample();
-        float lfo4Val = lfo4.getNextSample();
+        const int blockSize = juce::jmin(controlBlockSize, numSamples - blockStart);
+
+        // v2.1: Update LFO modulation sources (LFOs output -1 to +1, advanced per sample)
+        float lfo1Val = 0.0f, lfo2Val = 0.0f, lfo3Val = 0.0f, lfo4Val = 0.0f;
+        for (int sample = 0; sample < blockSize; ++sample)
+        {
+            lfo1Val = lfo1.getNextSample();
+            lfo2Val = lfo2.getNextSample();
+            lfo3Val = lfo3.getNextSample();
+            lfo4Val = lfo4.getNextSample();
+        }
 
         modMatrix.setSourceValue(ModSource::LFO1, lfo1Val);
         modMatrix.setSourceValue(ModSource::LFO2, lfo2Val);
@@ -1329,11 +1439,26 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
         modMatrix.setSourceValue(ModSource::LFO4, lfo4Val);
 
         // v2.1: Get modulated filter cutoff (if modulation is assigned)
-        float modulatedCutoff = modMatrix.hasModulation("filter_cutoff")
-            ? getModulatedParam("filter_cutoff")
+        float modulatedCutoff = modMatrix.hasModulation(filterCutoffId)
+            ? getModulatedParam(filterCutoffId)
             : filter_cutoff->load();
 
-        // Update filter with modulated cutoff for all voices
+        // Scratch memory is reused for every control block
+        scratchArena.reset();
+        float* leftMix = scratchArena.allocate(blockSize);
+        float* rightMix = scratchArena.allocate(blockSize);
+
+        if (leftMix == nullptr || rightMix == nullptr)
+            break;
+
+        juce::FloatVectorOperations::clear(leftMix, blockSize);
+        juce::FloatVectorOperations::clear(rightMix, blockSize);
+
+        // Per-sample wavetable positions while the mod matrix scans them (nullptr = parameter value)
+        const float* positionLaneA = getPositionLane(oscAPositionId, lastModulatedPositionA, blockSize);
+        const float* positionLaneB = getPositionLane(oscBPositionId, lastModulatedPositionB, blockSize);
+
+        // Update filter with modulated cutoff and sum all active voices (stereo)
         for (auto& voice : voices)
         {
             if (voice->isPlaying())
@@ -1346,41 +1471,38 @@ void CodoxAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
                     filter_env_depth->load(),
                     filter_keytrack->load()
                 );
+
+                voice->renderBlock(leftMix, rightMix, blockSize, scratchArena, positionLaneA, positionLaneB);
             }
         }
 
-        float leftMix = 0.0f;
-        float rightMix = 0.0f;
-
-        // Sum all active voices (stereo)
-        for (auto& voice : voices)
+        for (int i = 0; i < blockSize; ++i)
         {
-            if (voice->isPlaying())
-            {
-                float voiceLeft, voiceRight;
-                voice->getNextSampleStereo(voiceLeft, voiceRight);
-                leftMix += voiceLeft;
-                rightMix += voiceRight;
-            }
+            float left = leftMix[i];
+            float right = rightMix[i];
+
+            // Phase 3.5: Process through effects chain (AFTER voice summation, BEFORE master volume)
+            effectsChain.processStereo(left, right);
+
+            // Apply master volume
+            left *= masterVolumeLinear;
+            right *= masterVolumeLinear;
+
+            // Write to output channels
+            const int sample = blockStart + i;
+            if (numChannels >= 1)
+                buffer.setSample(0, sample, left);
+            if (numChannels >= 2)
+                buffer.setSample(1, sample, right);
+
+            // If more than 2 channels, copy left to extra channels
+            for (int channel = 2; channel < numChannels; ++channel)
+                buffer.setSample(channel, sample, left);
         }
-
-        // Phase 3.5: Process through effects chain (AFTER voice summation, BEFORE master volume)
-        effectsChain.processStereo(leftMix, rightMix);
-
-        // Apply master volume
-        leftMix *= masterVolumeLinear;
-        rightMix *= masterVolumeLinear;
-
-        // Write to output channels
-        if (numChannels >= 1)
-            buffer.setSample(0, sample, leftMix);
-        if (numChannels >= 2)
-            buffer.setSample(1, sample, rightMix);
-
-        // If more than 2 channels, copy left to extra channels
-        for (int channel = 2; channel < numChannels; ++channel)
-            buffer.setSample(channel, sample, leftMix);
     }
+
+    // Tables swapped out before this block can now be reclaimed by the loader
+    wavetableLoader.audioBlockFinished();
 }
 
 // Voice allocation: Round-robin with voice stealing (Phase 3.6: Added glide support)
@@ -1424,6 +1546,32 @@ float CodoxAudioProcessor::getModulatedParam(const juce::String& paramId)
     return modMatrix.getModulatedValue(paramId, baseValue, range.start, range.end);
 }
 
+// Per-sample osc position (0-1) for a control block while the mod matrix drives it, or nullptr
+// Ramps linearly from the previous block's modulated position, so wavetable scanning by an LFO
+// or envelope is smooth at audio rate while modulation itself is still evaluated per block
+const float* CodoxAudioProcessor::getPositionLane(const juce::String& paramId, float& lastPosition, int blockSize)
+{
+    if (!modMatrix.hasModulation(paramId))
+    {
+        lastPosition = -1.0f;
+        return nullptr;
+    }
+
+    float* lane = scratchArena.allocate(blockSize);
+    if (lane == nullptr)
+        return nullptr;
+
+    const float target = getModulatedParam(paramId) / 100.0f; // Convert 0-100% to 0.0-1.0
+    const float start = lastPosition < 0.0f ? target : lastPosition;
+    const float step = (target - start) / static_cast<float>(blockSize);
+
+    for (int i = 0; i < blockSize; ++i)
+        lane[i] = start + step * static_cast<float>(i + 1);
+
+    lastPosition = target;
+    return lane;
+}
+
 juce::AudioProcessorEditor* CodoxAudioProcessor::createEditor()
 {
     return new CodoxAudioProcessorEditor(*this);
@@ -1436,6 +1584,10 @@ void CodoxAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     // v2.1: Save modulation matrix state
     state.appendChild(modMatrix.getState(), nullptr);
 
+    // User wavetable files (empty = built-in table)
+    state.setProperty("osc_a_user_wavetable", wavetableLoader.getFilePath(0), nullptr);
+    state.setProperty("osc_b_user_wavetable", wavetableLoader.getFilePath(1), nullptr);
+
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
 }
@@ -1453,6 +1605,18 @@ void CodoxAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
         auto modMatrixState = state.getChildWithName("ModMatrix");
         if (modMatrixState.isValid())
             modMatrix.setState(modMatrixState);
+
+        // Reload user wavetables in the background (the built-in table plays until they are ready)
+        const juce::Identifier userWavetableIds[] = { "osc_a_user_wavetable", "osc_b_user_wavetable" };
+        for (int slot = 0; slot < WavetableLoader::numSlots; ++slot)
+        {
+            auto path = state.getProperty(userWavetableIds[slot]).toString();
+
+            if (juce::File::isAbsolutePath(path) && juce::File(path).existsAsFile())
+                wavetableLoader.loadFile(slot, juce::File(path));
+            else
+                wavetableLoader.clear(slot);
+        }
     }
 }
 
@@ -1,13 +1,16 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 #include "Voice.h"
 #include "EffectsChain.h"
 #include "LFO.h"
 #include "ModulationMatrix.h"
+#include "WavetableLoader.h"
 
-class CodoxAudioProcessor : public juce::AudioProcessor
+class CodoxAudioProcessor : public juce::AudioProcessor,
+                            private juce::AsyncUpdater
 {
 public:
     CodoxAudioProcessor();
@@ -40,6 +43,9 @@ public:
     // Modulation matrix - public for WebView access
     ModulationMatrix modMatrix;
 
+    // User wavetables for Osc A (slot 0) and Osc B (slot 1) - public for WebView access
+    WavetableLoader wavetableLoader;
+
     // Get modulated parameter value (applies all active modulations)
     float getModulatedParam(const juce::String& paramId);
 
@@ -52,6 +58,12 @@ private:
     std::vector<std::unique_ptr<Voice>> voices;
     int nextVoiceIndex = 0; // Round-robin voice allocation
 
+    // Block rendering: voices and modulation update in control blocks of up to 32 samples
+    static constexpr int controlBlockSize = PitchEngine::controlInterval;
+
+    // Real-time scratch memory for per-block voice rendering (reserved in prepareToPlay)
+    ScratchArena scratchArena;
+
     // Phase 3.5: Effects Chain
     EffectsChain effectsChain;
 
@@ -72,9 +84,31 @@ private:
     float currentAftertouch = 0.0f;    // 0-1
     float currentVelocity = 0.0f;      // Last note velocity (0-1)
 
+    // Ids of parameters the mod matrix is queried for every control block
+    // (built once: constructing a juce::String from a literal allocates, not on the audio thread)
+    static const juce::String filterCutoffId;
+    static const juce::String oscAPositionId;
+    static const juce::String oscBPositionId;
+
+    // Modulated osc positions (0-1) at the end of the previous control block (-1 = not modulated)
+    float lastModulatedPositionA = -1.0f;
+    float lastModulatedPositionB = -1.0f;
+
+    // Wavetable storage (wt_storage): what the parameter asks for, and what the audio thread plays
+    // The switch happens once the requested built-in tables are ready (see handleAsyncUpdate)
+    std::atomic<float>* tableStorage = nullptr;
+    Wavetable::SampleFormat activeTableFormat = Wavetable::defaultSampleFormat;
+    Wavetable::SampleFormat getRequestedTableFormat() const noexcept;
+    void handleAsyncUpdate() override;
+
+    // Live processors in this process: the last one to go cancels the built-in table build,
+    // so its thread is never joined during static destruction (see Wavetable::cancelBuiltInTables)
+    static std::atomic<int> numLiveInstances;
+
     // Helper methods
     void allocateVoice(int midiNote, float velocity, double sampleRate, float glideTime = 0.0f);
     void releaseVoice(int midiNote);
+    const float* getPositionLane(const juce::String& paramId, float& lastPosition, int blockSize);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CodoxAudioProcessor)
 };
@@ -0,0 +1,65 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <vector>
+#include <cstdint>
+
+// ScratchArena - Real-time bump allocator for per-block temporary buffers
+// All memory is reserved in prepare() (message thread). On the audio thread, allocate() only
+// bumps an offset and reset() rewinds it, so scratch buffers never touch the system allocator
+// and the same few cache-line-aligned addresses are reused every block.
+class ScratchArena
+{
+public:
+    static constexpr size_t alignmentFloats = 16; // 64 bytes: cache line, and enough for any SIMD width
+
+    // Reserve capacity for numFloats floats, given as a sum of getAlignedSize() calls
+    // (NOT real-time safe - call from prepareToPlay)
+    void prepare(size_t numFloats)
+    {
+        storage.assign(numFloats + alignmentFloats, 0.0f);
+
+        // Align the start of the arena to a cache line
+        auto address = reinterpret_cast<std::uintptr_t>(storage.data());
+        auto misalignment = (address / sizeof(float)) % alignmentFloats;
+        base = storage.data() + (misalignment == 0 ? 0 : alignmentFloats - misalignment);
+
+        capacity = numFloats;
+        used = 0;
+    }
+
+    // Release every allocation at once (real-time safe)
+    void reset() noexcept
+    {
+        used = 0;
+    }
+
+    // Hand out an aligned buffer of numFloats (real-time safe)
+    // Returns nullptr if the arena was sized too small; contents are uninitialised
+    float* allocate(int numFloats) noexcept
+    {
+        size_t size = getAlignedSize(numFloats);
+
+        if (base == nullptr || used + size > capacity)
+        {
+            jassertfalse; // prepare() did not reserve enough scratch memory
+            return nullptr;
+        }
+
+        float* buffer = base + used;
+        used += size;
+        return buffer;
+    }
+
+    // Space taken by an allocation of numFloats, rounded up to keep the next buffer aligned
+    static size_t getAlignedSize(int numFloats)
+    {
+        auto size = static_cast<size_t>(juce::jmax(0, numFloats));
+        return (size + alignmentFloats - 1) / alignmentFloats * alignmentFloats;
+    }
+
+private:
+    std::vector<float> storage;
+    float* base = nullptr;
+    size_t capacity = 0; // Usable floats from base
+    size_t used = 0;     // Floats handed out since the last reset()
+};
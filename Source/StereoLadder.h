@@ -0,0 +1,118 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+#include "FastMath.h"
+
+// StereoLadder - 4-pole (24dB/oct) transistor-ladder style lowpass, L and R together
+// Four topology-preserving one-pole stages inside a global resonance feedback loop; the
+// zero-delay feedback is solved in closed form (Zavalishin), so the response holds up near
+// Nyquist. Same layout as StereoSVF: lane 0 = left, lane 1 = right, shared coefficients.
+class StereoLadder
+{
+public:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+
+    static constexpr float maxFeedback = 3.95f; // Self-oscillation starts at 4
+
+    StereoLadder()
+    {
+        reset();
+        updateLoopGains();
+    }
+
+    void prepare(double sr)
+    {
+        sampleRate = sr;
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& state : s)
+            state = Lanes::expand(0.0f);
+    }
+
+    // Control-rate update: cutoff (Hz, below Nyquist) and resonance feedback (0 to maxFeedback)
+    // for the next rampSamples samples; g glides linearly over the ramp as in StereoSVF
+    void setParameterTargets(float newCutoff, float newFeedback, int rampSamples)
+    {
+        k = juce::jlimit(0.0f, maxFeedback, newFeedback);
+
+        const float newG = FastMath::tanPi(static_cast<float>(newCutoff / sampleRate));
+
+        if (rampSamples <= 0 || newG == g)
+        {
+            g = newG;
+            gStep = 0.0f;
+            rampSamplesRemaining = 0;
+        }
+        else
+        {
+            gTarget = newG;
+            gStep = (newG - g) / static_cast<float>(rampSamples);
+            rampSamplesRemaining = rampSamples;
+        }
+
+        updateLoopGains();
+    }
+
+    // Process one stereo sample pair in place
+    void processStereo(float& left, float& right)
+    {
+        if (rampSamplesRemaining > 0)
+        {
+            g = (--rampSamplesRemaining == 0) ? gTarget : g + gStep;
+            updateLoopGains();
+        }
+
+        alignas(Lanes::SIMDRegisterSize) float io[Lanes::SIMDNumElements] = {};
+        io[0] = left;
+        io[1] = right;
+
+        auto x = Lanes::fromRawArray(io);
+
+        // Each stage outputs G*input + S (S = its state scaled by 1/(1+g)), so the ladder
+        // output is G^4*u + (G^3*S1 + G^2*S2 + G*S3 + S4), with u = x - k*output
+        const float oneMinusG = 1.0f - G;
+        auto sigma = (((s[0] * G + s[1]) * G + s[2]) * G + s[3]) * oneMinusG;
+        auto y = (x * G4 + sigma) * feedbackNormalise;
+
+        // Run the stages with the resolved feedback
+        auto u = x - y * k;
+        for (auto& state : s)
+        {
+            auto v = (u - state) * G;
+            auto stageOut = v + state;
+            state = stageOut + v;
+            u = stageOut;
+        }
+
+        u.copyToRawArray(io);
+        left = io[0];
+        right = io[1];
+    }
+
+private:
+    double sampleRate = 44100.0;
+
+    float g = 0.0f;                     // Integrator gain tan(pi * fc / fs)
+    float G = 0.0f;                     // One-pole gain g / (1 + g)
+    float G4 = 0.0f;                    // G^4
+    float k = 0.0f;                     // Resonance feedback
+    float feedbackNormalise = 1.0f;     // 1 / (1 + k*G^4)
+
+    // g ramp between control-rate updates (see setParameterTargets)
+    float gTarget = 0.0f;
+    float gStep = 0.0f;
+    int rampSamplesRemaining = 0;
+
+    // One-pole integrator states, one lane per channel
+    Lanes s[4];
+
+    void updateLoopGains()
+    {
+        G = g / (1.0f + g);
+        G4 = (G * G) * (G * G);
+        feedbackNormalise = 1.0f / (1.0f + k * G4);
+    }
+};
@@ -0,0 +1,197 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+#include "FastMath.h"
+
+// StereoSVF - Topology-preserving state variable filter processing L and R together
+// Same response as juce::dsp::StateVariableTPTFilter, but both channels live in one SIMD register
+// (lane 0 = left, lane 1 = right) and share a single coefficient update per sample.
+// Lanes 2-3 hold a second 2-pole stage for the 4-pole (24dB/oct) cascade: it filters the first
+// stage's previous output, so both stages run in the same instructions and the cascade costs
+// the same as one stage, for one sample of latency.
+class StereoSVF
+{
+public:
+    enum class Type
+    {
+        lowpass = 0,
+        bandpass,
+        highpass,
+        notch       // Lowpass + highpass (input minus the damped bandpass)
+    };
+
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static_assert(Lanes::SIMDNumElements >= 4, "Cascade needs lanes for two stereo stages");
+
+    StereoSVF()
+    {
+        reset();
+        updateCoefficients();
+    }
+
+    void prepare(double sr)
+    {
+        sampleRate = sr;
+        updateCoefficients();
+        reset();
+    }
+
+    void reset()
+    {
+        s1 = Lanes::expand(0.0f);
+        s2 = Lanes::expand(0.0f);
+        stageOutput = Lanes::expand(0.0f);
+    }
+
+    void setType(Type newType)
+    {
+        type = newType;
+    }
+
+    // Two stages (4-pole, 24dB/oct) or one (2-pole, 12dB/oct)
+    // The second stage always runs, so switching keeps its state warm
+    void setCascaded(bool shouldCascade)
+    {
+        cascaded = shouldCascade;
+    }
+
+    // Cutoff in Hz (caller keeps it below Nyquist)
+    void setCutoffFrequency(float newCutoff)
+    {
+        cutoff = newCutoff;
+        updateCoefficients();
+    }
+
+    // Resonance as Q factor (0.707 = Butterworth)
+    void setResonance(float newResonance)
+    {
+        resonance = newResonance;
+        updateCoefficients();
+    }
+
+    // Control-rate update: cutoff and resonance for the next rampSamples samples
+    // g (fast tan) glides linearly to the new cutoff's value over the ramp, so the caller
+    // only needs to update every few samples; rampSamples = 0 jumps there immediately
+    // secondStageResonance is the cascade stage's Q (a 4-pole response needs two Qs)
+    void setParameterTargets(float newCutoff, float newResonance, float secondStageResonance, int rampSamples)
+    {
+        cutoff = newCutoff;
+        resonance = newResonance;
+        R2 = 1.0f / resonance;
+        R2Second = 1.0f / secondStageResonance;
+
+        const float newG = FastMath::tanPi(static_cast<float>(cutoff / sampleRate));
+
+        if (rampSamples <= 0 || newG == g)
+        {
+            g = newG;
+            gStep = 0.0f;
+            rampSamplesRemaining = 0;
+        }
+        else
+        {
+            gTarget = newG;
+            gStep = (newG - g) / static_cast<float>(rampSamples);
+            rampSamplesRemaining = rampSamples;
+        }
+
+        updateLoopGains();
+    }
+
+    // Process one stereo sample pair in place
+    void processStereo(float& left, float& right)
+    {
+        if (rampSamplesRemaining > 0)
+        {
+            g = (--rampSamplesRemaining == 0) ? gTarget : g + gStep;
+            updateLoopGains();
+        }
+
+        // Lanes 0-1: new input; lanes 2-3: the first stage's previous output
+        alignas(Lanes::SIMDRegisterSize) float io[Lanes::SIMDNumElements] = {};
+        stageOutput.copyToRawArray(io);
+        io[2] = io[0];
+        io[3] = io[1];
+        io[0] = left;
+        io[1] = right;
+
+        auto x = Lanes::fromRawArray(io);
+
+        // TPT SVF (Zavalishin): solve the zero-delay feedback loop for highpass, then integrate
+        auto yHP = (x - s1 * (gLanes + R2Lanes) - s2) * hLanes;
+
+        auto v1 = yHP * gLanes;
+        auto yBP = v1 + s1;
+        s1 = yBP + v1;
+
+        auto v2 = yBP * gLanes;
+        auto yLP = v2 + s2;
+        s2 = yLP + v2;
+
+        switch (type)
+        {
+            case Type::lowpass:  stageOutput = yLP; break;
+            case Type::bandpass: stageOutput = yBP; break;
+            case Type::highpass: stageOutput = yHP; break;
+            case Type::notch:    stageOutput = yLP + yHP; break;
+        }
+
+        stageOutput.copyToRawArray(io);
+        const int outputLane = cascaded ? 2 : 0;
+        left = io[outputLane];
+        right = io[outputLane + 1];
+    }
+
+private:
+    Type type = Type::lowpass;
+    float cutoff = 1000.0f;
+    float resonance = 1.0f / juce::MathConstants<float>::sqrt2;
+    double sampleRate = 44100.0;
+
+    bool cascaded = false;
+
+    // Shared coefficients (identical for both channels)
+    float g = 0.0f;         // Integrator gain tan(pi * fc / fs)
+    float R2 = 0.0f;        // Damping 1/Q
+    float R2Second = 0.0f;  // Second stage damping (lanes 2-3)
+
+    // Per-lane copies for the SIMD loop; h = 1 / (1 + R2*g + g*g) normalises the feedback loop
+    Lanes gLanes;
+    Lanes R2Lanes;
+    Lanes hLanes;
+
+    // g ramp between control-rate updates (see setParameterTargets)
+    float gTarget = 0.0f;
+    float gStep = 0.0f;
+    int rampSamplesRemaining = 0;
+
+    // Integrator states, one lane per channel and stage
+    Lanes s1;
+    Lanes s2;
+    Lanes stageOutput; // Last output of every lane (lanes 0-1 feed the second stage)
+
+    void updateCoefficients()
+    {
+        rampSamplesRemaining = 0;
+        g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate));
+        R2 = 1.0f / resonance;
+        R2Second = R2;
+        updateLoopGains();
+    }
+
+    // Refresh the per-lane coefficients after g or the damping changed
+    void updateLoopGains()
+    {
+        alignas(Lanes::SIMDRegisterSize) float damping[Lanes::SIMDNumElements] = {};
+        alignas(Lanes::SIMDRegisterSize) float loopGain[Lanes::SIMDNumElements] = {};
+
+        damping[0] = damping[1] = R2;
+        damping[2] = damping[3] = R2Second;
+        loopGain[0] = loopGain[1] = 1.0f / (1.0f + R2 * g + g * g);
+        loopGain[2] = loopGain[3] = 1.0f / (1.0f + R2Second * g + g * g);
+
+        gLanes = Lanes::expand(g);
+        R2Lanes = Lanes::fromRawArray(damping);
+        hLanes = Lanes::fromRawArray(loopGain);
+    }
+};
@@ -1,8 +1,10 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <cstdint>
 
 // SubOscillator - Phase 3.3: Simple oscillator with waveform selection
 // Generates sine, triangle, or square waves at -2, -1, or 0 octaves below base note
+// Phase is a uint32 fraction of a cycle (wraps for free on overflow, no drift)
 class SubOscillator
 {
 public:
@@ -30,55 +32,101 @@ public:
         frequency = baseFreq * std::pow(2.0f, static_cast<float>(octaveOffset));
 
         // Calculate phase increment per sample
-        phaseIncrement = (frequency * juce::MathConstants<float>::twoPi) / static_cast<float>(sampleRate);
+        setPhaseIncrementTarget((frequency * juce::MathConstants<float>::twoPi) / static_cast<float>(sampleRate), 0);
+    }
+
+    // Get octave offset (-2, -1, 0) for pitch calculations
+    int getOctaveOffset() const
+    {
+        return octaveOffset;
+    }
+
+    // Ramp the phase increment (radians/sample) linearly to target over rampSamples (0 = jump)
+    void setPhaseIncrementTarget(float targetIncrement, int rampSamples)
+    {
+        rampTarget = static_cast<uint32_t>(juce::jlimit(0.0, 4294967295.0, targetIncrement * phaseUnitsPerRadian));
+
+        if (rampSamples <= 0)
+        {
+            phaseIncrement = rampTarget;
+            incrementStep = 0;
+            rampSamplesRemaining = 0;
+            return;
+        }
+
+        incrementStep = static_cast<int32_t>((static_cast<int64_t>(rampTarget) - static_cast<int64_t>(phaseIncrement)) / rampSamples);
+        rampSamplesRemaining = rampSamples;
     }
 
     // Generate next sample
     float getNextSample()
     {
         float output = 0.0f;
+        const float radians = static_cast<float>(phase) * radiansPerPhaseUnit;
 
         switch (shape)
         {
             case 0: // Sine
-                output = std::sin(phase);
+                output = std::sin(radians);
                 break;
 
             case 1: // Triangle
                 // Triangle wave using arcsin formula: output = (2/π) × arcsin(sin(phase))
-                output = (2.0f / juce::MathConstants<float>::pi) * std::asin(std::sin(phase));
+                output = (2.0f / juce::MathConstants<float>::pi) * std::asin(std::sin(radians));
                 break;
 
             case 2: // Square
-                // Square wave: positive for first half of cycle, negative for second half
-                output = phase < juce::MathConstants<float>::pi ? 1.0f : -1.0f;
+                // Square wave: positive for first half of cycle (top phase bit clear), negative for second half
+                output = phase < 0x80000000u ? 1.0f : -1.0f;
                 break;
 
             default:
                 output = 0.0f;
         }
 
-        // Increment phase and wrap
+        // Increment phase (wraps on overflow)
         phase += phaseIncrement;
-        if (phase >= juce::MathConstants<float>::twoPi)
-            phase -= juce::MathConstants<float>::twoPi;
+
+        // Advance pitch ramp, landing exactly on the target
+        if (rampSamplesRemaining > 0)
+        {
+            phaseIncrement += static_cast<uint32_t>(incrementStep);
+            if (--rampSamplesRemaining == 0)
+                phaseIncrement = rampTarget;
+        }
 
         return output;
     }
 
+    // Render numSamples into out
+    void renderBlock(float* out, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = getNextSample();
+    }
+
     // Reset oscillator state
     void reset()
     {
-        phase = 0.0f;
+        phase = 0;
         frequency = 0.0f;
-        phaseIncrement = 0.0f;
+        phaseIncrement = 0;
+        incrementStep = 0;
+        rampSamplesRemaining = 0;
     }
 
 private:
     int shape = 0;              // 0=Sine, 1=Triangle, 2=Square
     int octaveOffset = -1;      // -2, -1, or 0 octaves
-    float phase = 0.0f;         // Current phase (0 to 2π)
+    // Phase units: 2^32 per cycle (2π)
+    static constexpr double phaseUnitsPerRadian = 4294967296.0 / juce::MathConstants<double>::twoPi;
+    static constexpr float radiansPerPhaseUnit = juce::MathConstants<float>::twoPi / 4294967296.0f;
+
+    uint32_t phase = 0;         // Current phase (2^32 = one cycle)
     float frequency = 0.0f;     // Current frequency (Hz)
-    float phaseIncrement = 0.0f; // Phase increment per sample
+    uint32_t phaseIncrement = 0; // Phase units per sample
+    uint32_t rampTarget = 0;     // Increment the ramp ends on
+    int32_t incrementStep = 0;   // Per-sample increment change while ramping
+    int rampSamplesRemaining = 0;
     double sampleRate = 44100.0;
 };
@@ -0,0 +1,75 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <cmath>
+#include "FastMath.h"
+
+// UnisonTables - Detune and pan factors for unison voices
+// Keyed by (unison count, quantized detune). A voice computes the factors for its key only when
+// the key changes (16 FastMath::exp2 calls, no allocation - safe on the audio thread) and keeps
+// them, so steady unison settings cost a comparison per block and nothing is built up front.
+class UnisonTables
+{
+public:
+    static constexpr int maxUnisonVoices = 16;
+    static constexpr int numUnisonCounts = 5; // 1, 2, 4, 8, 16 voices
+    static constexpr int numDetuneSteps = 1000; // unison_detune has 0.1% resolution (0-100%)
+    static constexpr float maxDetuneSemitones = 0.5f; // ±50 cents at 100%
+
+    // Factors for one (count, detune) combination
+    struct Table
+    {
+        int unisonCount = 1;
+        std::array<float, maxUnisonVoices> detuneFactors {}; // Frequency multipliers
+        std::array<float, maxUnisonVoices> panFactors {};    // -1.0 (left) to +1.0 (right)
+    };
+
+    // Convert unison index (0-4) to actual voice count (1, 2, 4, 8, 16)
+    static int getUnisonCount(int countIndex)
+    {
+        static constexpr int unisonCounts[] = {1, 2, 4, 8, 16};
+        return unisonCounts[juce::jlimit(0, numUnisonCounts - 1, countIndex)];
+    }
+
+    // Quantize detune (0-100%) to a table step
+    static int getDetuneStep(float detunePercent)
+    {
+        return juce::jlimit(0, numDetuneSteps, static_cast<int>(std::lround(detunePercent * (numDetuneSteps / 100.0f))));
+    }
+
+    // Factors for a unison index (0-4) and quantized detune step (real-time safe)
+    static void fillTable(Table& table, int countIndex, int detuneStep)
+    {
+        const int unisonCount = getUnisonCount(countIndex);
+        const int step = juce::jlimit(0, numDetuneSteps, detuneStep);
+
+        table.unisonCount = unisonCount;
+        table.detuneFactors.fill(1.0f);
+        table.panFactors.fill(0.0f);
+
+        // No unison: single voice, no detune, centered
+        if (unisonCount == 1)
+            return;
+
+        float detuneAmount = (step / static_cast<float>(numDetuneSteps)) * maxDetuneSemitones;
+
+        // Symmetric spread: voice 0 at -detuneAmount, voice N-1 at +detuneAmount
+        for (int i = 0; i < unisonCount; ++i)
+        {
+            // Symmetric offset: -0.5 to +0.5
+            float offset = (static_cast<float>(i) / (unisonCount - 1)) - 0.5f;
+
+            // Convert semitones to frequency multiplier: freq × 2^(semitones/12)
+            float detuneSemitones = offset * 2.0f * detuneAmount;
+            table.detuneFactors[static_cast<size_t>(i)] = FastMath::exp2(detuneSemitones / 12.0f);
+
+            // Voice 0 far left (-1.0), Voice N-1 far right (+1.0)
+            table.panFactors[static_cast<size_t>(i)] = offset * 2.0f;
+        }
+    }
+
+private:
+    UnisonTables() = delete; // Static functions only
+
+    JUCE_DECLARE_NON_COPYABLE(UnisonTables)
+};
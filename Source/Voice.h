@@ -5,6 +5,9 @@
 #include "SubOscillator.h"
 #include "NoiseOscillator.h"
 #include "FilterBank.h"
+#include "UnisonTables.h"
+#include "PitchEngine.h"
+#include "ScratchArena.h"
 
 // Voice class - Phase 3.4: Added Unison Processing
 // Complete subtractive synthesis path: Oscillators → Mix → Unison Expansion → Filter → Amp Envelope
@@ -18,11 +21,15 @@ public:
 
         // Initialize unison parameters
         unisonCount = 1; // Default: no unison (1 voice)
-        detuneAmount = 0.0f;
         stereoSpread = 0.5f;
+        UnisonTables::fillTable(unisonTable, 0, 0);
 
-        // Pre-calculate detune factors for max unison count (will use subset based on unisonCount)
-        calculateDetuneFactors();
+        // All unison oscillators of A (and of B) share one blended-frame cache
+        for (int i = 0; i < maxUnisonVoices; ++i)
+        {
+            unisonOscA[i].setFrameCache(&frameCacheA);
+            unisonOscB[i].setFrameCache(&frameCacheB);
+        }
     }
 
     // Note-on: trigger voice
@@ -33,39 +40,24 @@ public:
         isActive = true;
         sampleRate = sr;
 
-        // Calculate target frequency from MIDI note
-        float targetFreq = 440.0f * std::pow(2.0f, (noteNumber - 69) / 12.0f);
-
-        // Phase 3.6: Glide/Portamento
-        if (glideTimeSeconds > 0.0f && frequency > 0.0f)
-        {
-            // Glide from current frequency to target frequency
-            targetFrequency = targetFreq;
-            glideActive = true;
-
-            // Calculate glide coefficient (exponential smoothing)
-            // Formula: coeff = 1.0 - exp(-1.0 / (glideTime * sampleRate))
-            glideCoefficient = 1.0f - std::exp(-1.0f / (glideTimeSeconds * static_cast<float>(sampleRate)));
-        }
-        else
-        {
-            // No glide: instant frequency change
-            frequency = targetFreq;
-            targetFrequency = targetFreq;
-            glideActive = false;
-        }
+        // Phase 3.6: Glide/Portamento (glides from the previous note when enabled)
+        pitchEngine.setSampleRate(sampleRate);
+        pitchEngine.noteOn(noteNumber, glideTimeSeconds);
 
-        // Reset all unison oscillators
+        // Reset all unison oscillators (and their blended frames - the table may have changed while idle)
         for (int i = 0; i < maxUnisonVoices; ++i)
         {
             unisonOscA[i].reset();
             unisonOscB[i].reset();
         }
+        frameCacheA.reset();
+        frameCacheB.reset();
         subOsc.reset();
         noiseOsc.reset();
 
-        // Set sub oscillator frequency
-        subOsc.setFrequency(frequency, sampleRate);
+        // Set all oscillator pitches immediately (no ramp on note start)
+        updatePitch(0);
+        samplesUntilPitchUpdate = PitchEngine::controlInterval;
 
         // Reset filter and trigger filter envelope
         filter.reset();
@@ -96,58 +88,80 @@ public:
         return midiNote;
     }
 
+    // Set intra-frame interpolation for both wavetable oscillators (0: Linear, 1: Cubic, 2: Hermite)
+    void setInterpolation(int mode)
+    {
+        for (int i = 0; i < maxUnisonVoices; ++i)
+        {
+            unisonOscA[i].setInterpolation(mode);
+            unisonOscB[i].setInterpolation(mode);
+        }
+    }
+
+    // Sample format of the built-in tables the oscillators read (user tables keep their own)
+    void setTableFormat(Wavetable::SampleFormat format)
+    {
+        tableFormat = format;
+    }
+
     // Update oscillator A parameters
+    // userTable overrides the built-in wavetable when set (valid for the current block)
     void updateOscillatorA(int wavetable, float position, float level, float pan,
                            int octave, int semitone, int fine,
-                           int warpMode, float warpAmount)
+                           int warpMode, float warpAmount,
+                           const Wavetable::Table* userTable = nullptr)
     {
         // Update all unison oscillators with same parameters
-        // Frequency will be detuned individually during sample generation
+        // Pitch (tuning + detune) is applied by the pitch engine at control rate
         for (int i = 0; i < maxUnisonVoices; ++i)
         {
-            unisonOscA[i].setWavetable(wavetable);
+            if (userTable != nullptr)
+                unisonOscA[i].setWavetable(userTable);
+            else
+                unisonOscA[i].setWavetable(wavetable, tableFormat);
             unisonOscA[i].setPosition(position / 100.0f); // Convert 0-100% to 0.0-1.0
             unisonOscA[i].setWarpMode(warpMode);
             unisonOscA[i].setWarpAmount(warpAmount / 100.0f); // Convert 0-100% to 0.0-1.0
-
-            // Calculate detuned frequency for this unison voice
-            float detunedFreq = frequency * detuneFactors[i];
-            unisonOscA[i].setFrequency(detunedFreq, octave - 4, semitone, fine, sampleRate); // octave param is index 0-8, convert to -4 to +4
         }
 
+        // octave param is index 0-8, convert to -4 to +4
+        oscA_tune = getTuneSemitones(octave - 4, semitone, fine);
+
         // Store level and pan for mixing
         oscA_level = level / 100.0f; // Convert 0-100% to 0.0-1.0
-        oscA_pan = pan / 100.0f; // Convert -100 to +100 to -1.0 to +1.0
+        setOscPan(oscA_pan, pan / 100.0f); // Convert -100 to +100 to -1.0 to +1.0
     }
 
     // Update oscillator B parameters
+    // userTable overrides the built-in wavetable when set (valid for the current block)
     void updateOscillatorB(int wavetable, float position, float level, float pan,
                            int octave, int semitone, int fine,
-                           int warpMode, float warpAmount)
+                           int warpMode, float warpAmount,
+                           const Wavetable::Table* userTable = nullptr)
     {
         // Update all unison oscillators with same parameters
         for (int i = 0; i < maxUnisonVoices; ++i)
         {
-            unisonOscB[i].setWavetable(wavetable);
+            if (userTable != nullptr)
+                unisonOscB[i].setWavetable(userTable);
+            else
+                unisonOscB[i].setWavetable(wavetable, tableFormat);
             unisonOscB[i].setPosition(position / 100.0f);
             unisonOscB[i].setWarpMode(warpMode);
             unisonOscB[i].setWarpAmount(warpAmount / 100.0f);
-
-            // Calculate detuned frequency for this unison voice
-            float detunedFreq = frequency * detuneFactors[i];
-            unisonOscB[i].setFrequency(detunedFreq, octave - 4, semitone, fine, sampleRate);
         }
 
+        oscB_tune = getTuneSemitones(octave - 4, semitone, fine);
+
         oscB_level = level / 100.0f;
-        oscB_pan = pan / 100.0f;
+        setOscPan(oscB_pan, pan / 100.0f);
     }
 
     // Update sub oscillator parameters
     void updateSubOscillator(int shape, int octaveIndex, float level)
     {
         subOsc.setShape(shape); // 0=Sine, 1=Triangle, 2=Square
-        subOsc.setOctaveOffset(octaveIndex); // 0=-2, 1=-1, 2=0
-        subOsc.setFrequency(frequency, sampleRate);
+        subOsc.setOctaveOffset(octaveIndex); // 0=-2, 1=-1, 2=0 (pitch follows at next control update)
 
         sub_level = level / 100.0f; // Convert 0-100% to 0.0-1.0
     }
@@ -160,11 +174,17 @@ public:
         noise_level = level / 100.0f; // Convert 0-100% to 0.0-1.0
     }
 
+    // Set pitch bend (-1 to +1), applied at the next control-rate pitch update
+    void setPitchBend(float bend)
+    {
+        pitchEngine.setPitchBend(bend);
+    }
+
     // Update filter parameters
     void updateFilter(int filterType, float cutoff, float resonance, float drive,
                       float envDepth, float keytrack)
     {
-        filter.setFilterType(filterType); // 0=LP24, 1=LP12, 2=HP24, 3=BP12, 4=Notch
+        filter.setFilterType(filterType); // 0=LP24, 1=LP12, 2=HP24, 3=BP12, 4=Notch, 5=Ladder
         filter.setCutoffFrequency(cutoff); // 20-20000 Hz
         filter.setResonance(resonance); // 0-100%
         filter.setDrive(drive); // 0-100%
@@ -181,19 +201,29 @@ public:
     // Update unison parameters (Phase 3.4)
     void updateUnisonParameters(int unisonIndex, float detune, float spread)
     {
-        // Convert unison index (0-4) to actual voice count (1, 2, 4, 8, 16)
-        static const int unisonCounts[] = {1, 2, 4, 8, 16};
-        unisonCount = unisonCounts[unisonIndex];
+        // Detune is quantized to the parameter's 0.1% step (max ±50 cents at 100%)
+        int detuneStep = UnisonTables::getDetuneStep(detune);
+        float newSpread = spread / 100.0f; // Convert 0-100% to 0.0-1.0
 
-        // Convert detune parameter from 0-100% to 0.0-1.0, then scale to semitones
-        // Max detune is ±0.5 semitones (50 cents) at 100%
-        detuneAmount = (detune / 100.0f) * 0.5f; // 0-100% → 0.0-0.5 semitones
+        // Only recompute the factors when unison settings actually change
+        if (unisonIndex != unisonCountIndex || detuneStep != unisonDetuneStep)
+        {
+            unisonCountIndex = unisonIndex;
+            unisonDetuneStep = detuneStep;
+            UnisonTables::fillTable(unisonTable, unisonIndex, detuneStep);
 
-        // Convert spread parameter from 0-100% to 0.0-1.0
-        stereoSpread = spread / 100.0f;
+            if (unisonTable.unisonCount != unisonCount)
+                panGainsDirty = true;
 
-        // Recalculate detune factors for new unison count
-        calculateDetuneFactors();
+            unisonCount = unisonTable.unisonCount;
+        }
+
+        // Pan gains only depend on unison count and spread (plus osc pans)
+        if (newSpread != stereoSpread)
+        {
+            stereoSpread = newSpread;
+            panGainsDirty = true;
+        }
     }
 
     // Generate next audio sample (mono - for backward compatibility)
@@ -223,110 +253,55 @@ public:
         return mixedSample;
     }
 
-    // Generate next stereo sample pair (Phase 3.4 - Added Unison Processing)
-    void getNextSampleStereo(float& leftOut, float& rightOut)
+    // Scratch buffers renderBlock() takes from the arena per call (see getScratchSize)
+    static constexpr int numScratchBuffers = 4;
+
+    // Arena space one voice needs to render up to maxBlockSize samples
+    static size_t getScratchSize(int maxBlockSize)
+    {
+        return numScratchBuffers * ScratchArena::getAlignedSize(maxBlockSize);
+    }
+
+    // Render numSamples of stereo output and ADD it to leftOut/rightOut (Phase 3.4 - Unison Processing)
+    // Temporary buffers come from the arena, so nothing is allocated on the audio thread
+    // positionLaneA/B (optional, numSamples long) modulate the oscillators' frame positions per sample
+    void renderBlock(float* leftOut, float* rightOut, int numSamples, ScratchArena& arena,
+                     const float* positionLaneA = nullptr, const float* positionLaneB = nullptr)
     {
         if (!isActive)
-        {
-            leftOut = 0.0f;
-            rightOut = 0.0f;
             return;
-        }
-
-        // Phase 3.6: Update glide (smooth frequency transition)
-        if (glideActive)
-        {
-            frequency += (targetFrequency - frequency) * glideCoefficient;
 
-            // Stop gliding when very close to target (within 0.1%)
-            if (std::abs(frequency - targetFrequency) < (targetFrequency * 0.001f))
-            {
-                frequency = targetFrequency;
-                glideActive = false;
-            }
+        float* oscBuffer = arena.allocate(numSamples);
+        float* oscBufferB = arena.allocate(numSamples); // Osc B's block, kept for cross-modulating osc A
+        float* leftMix = arena.allocate(numSamples);
+        float* rightMix = arena.allocate(numSamples);
 
-            // Update sub oscillator frequency (sub tracks main frequency)
-            subOsc.setFrequency(frequency, sampleRate);
-        }
+        if (oscBuffer == nullptr || oscBufferB == nullptr || leftMix == nullptr || rightMix == nullptr)
+            return;
 
-        // Initialize accumulator for unison voices
-        float leftMix = 0.0f;
-        float rightMix = 0.0f;
+        // Unison oscillators share table and position; reuse the blended frames if they held still
+        frameCacheA.update(unisonOscA[0].getWavetable(), positionLaneA != nullptr ? positionLaneA[0] : unisonOscA[0].getPosition());
+        frameCacheB.update(unisonOscB[0].getWavetable(), positionLaneB != nullptr ? positionLaneB[0] : unisonOscB[0].getPosition());
 
-        // Process each active unison voice
-        for (int unisonIndex = 0; unisonIndex < unisonCount; ++unisonIndex)
+        // Split the block at control-rate pitch updates (glide, pitch bend, tuning, unison detune)
+        int samplesDone = 0;
+        while (samplesDone < numSamples && isActive)
         {
-            // Generate samples from detuned wavetable oscillators (already configured with detuned frequencies)
-            float sampleA = unisonOscA[unisonIndex].getNextSample() * oscA_level;
-            float sampleB = unisonOscB[unisonIndex].getNextSample() * oscB_level;
-
-            // Calculate stereo panning for this unison voice
-            float unisonPan = panFactors[unisonIndex] * stereoSpread; // -1.0 to +1.0
-
-            // Apply oscillator-specific panning FIRST, then unison stereo spread
-            // Convert pan from -1..1 to 0..1 range for constant-power law
-            float panA = (oscA_pan + unisonPan + 1.0f) * 0.5f;
-            panA = juce::jlimit(0.0f, 1.0f, panA); // Clamp to valid range
-            float gainL_A = std::cos(panA * juce::MathConstants<float>::halfPi);
-            float gainR_A = std::sin(panA * juce::MathConstants<float>::halfPi);
-
-            float panB = (oscB_pan + unisonPan + 1.0f) * 0.5f;
-            panB = juce::jlimit(0.0f, 1.0f, panB);
-            float gainL_B = std::cos(panB * juce::MathConstants<float>::halfPi);
-            float gainR_B = std::sin(panB * juce::MathConstants<float>::halfPi);
-
-            // Mix wavetable oscillators with panning applied for this unison voice
-            float leftSample = (sampleA * gainL_A) + (sampleB * gainL_B);
-            float rightSample = (sampleA * gainR_A) + (sampleB * gainR_B);
-
-            // Add sub oscillator (mono, centered - only once for first unison voice to avoid excessive bass)
-            if (unisonIndex == 0)
+            if (samplesUntilPitchUpdate <= 0)
             {
-                float subSample = subOsc.getNextSample() * sub_level;
-                leftSample += subSample;
-                rightSample += subSample;
+                updatePitch(PitchEngine::controlInterval);
+                samplesUntilPitchUpdate = PitchEngine::controlInterval;
             }
 
-            // Add noise oscillator (stereo, same noise - only once for first unison voice)
-            if (unisonIndex == 0)
-            {
-                float noiseSample = noiseOsc.getNextSample() * noise_level;
-                leftSample += noiseSample;
-                rightSample += noiseSample;
-            }
+            int segmentSize = juce::jmin(numSamples - samplesDone, samplesUntilPitchUpdate);
+            renderSegment(leftOut + samplesDone, rightOut + samplesDone, segmentSize,
+                          oscBuffer, oscBufferB, leftMix, rightMix,
+                          positionLaneA != nullptr ? positionLaneA + samplesDone : nullptr,
+                          positionLaneB != nullptr ? positionLaneB + samplesDone : nullptr);
 
-            // Accumulate this unison voice to the mix
-            leftMix += leftSample;
-            rightMix += rightSample;
+            samplesUntilPitchUpdate -= segmentSize;
+            samplesDone += segmentSize;
         }
-
-        // Normalize by unison count to maintain consistent loudness
-        // Use sqrt to maintain constant power (energy preservation)
-        float unisonGain = 1.0f / std::sqrt(static_cast<float>(unisonCount));
-        leftMix *= unisonGain;
-        rightMix *= unisonGain;
-
-        // Apply velocity to mixed oscillators
-        leftMix *= velocity;
-        rightMix *= velocity;
-
-        // Process through filter (per-channel)
-        // Filter processes left and right independently
-        leftMix = filter.processSample(leftMix, midiNote);
-        rightMix = filter.processSample(rightMix, midiNote);
-
-        // Apply amp envelope AFTER filter (standard subtractive synthesis order)
-        float envValue = ampEnvelope.getNextSample();
-        leftMix *= envValue;
-        rightMix *= envValue;
-
-        // Check if envelope finished
-        if (inRelease && envValue < 0.0001f)
-            isActive = false;
-
-        // Output stereo samples
-        leftOut = leftMix;
-        rightOut = rightMix;
     }
 
     // Update envelope parameters
@@ -344,13 +319,10 @@ public:
         // Prepare filter with new sample rate
         filter.prepareToPlay(sampleRate);
 
-        // Update oscillator frequencies with new sample rate
+        // Update oscillator pitches with new sample rate
+        pitchEngine.setSampleRate(sampleRate);
         if (isActive)
-        {
-            // Recalculate frequencies (tuning parameters stored in oscillators)
-            // This will be called during voice update cycle
-            subOsc.setFrequency(frequency, sampleRate);
-        }
+            updatePitch(0);
     }
 
     // Reset voice state
@@ -360,8 +332,8 @@ public:
         inRelease = false;
         midiNote = -1;
         velocity = 0.0f;
-        frequency = 0.0f;
         sampleRate = 44100.0;
+        pitchEngine.reset();
 
         oscA_level = 1.0f;
         oscA_pan = 0.0f;
@@ -369,12 +341,15 @@ public:
         oscB_pan = 0.0f;
         sub_level = 0.0f;
         noise_level = 0.0f;
+        panGainsDirty = true;
 
         for (int i = 0; i < maxUnisonVoices; ++i)
         {
             unisonOscA[i].reset();
             unisonOscB[i].reset();
         }
+        frameCacheA.reset();
+        frameCacheB.reset();
         subOsc.reset();
         noiseOsc.reset();
         filter.reset();
@@ -383,25 +358,33 @@ public:
 
 private:
     // Phase 3.4: Unison constant (must be declared before arrays that use it)
-    static constexpr int maxUnisonVoices = 16;
+    static constexpr int maxUnisonVoices = UnisonTables::maxUnisonVoices;
 
     bool isActive = false;
     bool inRelease = false;
     int midiNote = -1;
     float velocity = 0.0f;
-    float frequency = 0.0f;
     double sampleRate = 44100.0;
 
     // Oscillators (Phase 3.4: Arrays for unison expansion)
     std::array<WavetableOscillator, maxUnisonVoices> unisonOscA;
     std::array<WavetableOscillator, maxUnisonVoices> unisonOscB;
 
+    // Morphed frames shared by each oscillator's unison copies (used while position is static)
+    BlendedFrameCache frameCacheA;
+    BlendedFrameCache frameCacheB;
+    Wavetable::SampleFormat tableFormat = Wavetable::defaultSampleFormat; // Built-in tables' format
+
     // Oscillator levels and panning
     float oscA_level = 1.0f;
     float oscA_pan = 0.0f;
     float oscB_level = 1.0f;
     float oscB_pan = 0.0f;
 
+    // Oscillator tuning relative to the played note (octave + semitone + fine, in semitones)
+    float oscA_tune = 0.0f;
+    float oscB_tune = 0.0f;
+
     // Phase 3.3: Sub oscillator, Noise oscillator, Filter
     SubOscillator subOsc;
     NoiseOscillator noiseOsc;
@@ -415,46 +398,149 @@ private:
 
     // Phase 3.4: Unison processing
     int unisonCount = 1; // 1, 2, 4, 8, or 16 voices
-    float detuneAmount = 0.0f; // 0.0-0.5 semitones (0-50 cents)
     float stereoSpread = 0.5f; // 0.0-1.0 (0-100%)
 
-    // Pre-calculated detune and pan factors for each unison voice
-    std::array<float, maxUnisonVoices> detuneFactors;
-    std::array<float, maxUnisonVoices> panFactors;
+    // Detune and pan factors for the current unison count/detune (see UnisonTables)
+    UnisonTables::Table unisonTable;
+    int unisonCountIndex = 0; // 0-4 index the factors were computed for
+    int unisonDetuneStep = 0; // Quantized detune step the factors were computed for
+
+    // Cached constant-power L/R gains per unison voice for osc A and B
+    // Recomputed only when osc pan, stereo spread or unison count change
+    std::array<float, maxUnisonVoices> panGainL_A;
+    std::array<float, maxUnisonVoices> panGainR_A;
+    std::array<float, maxUnisonVoices> panGainL_B;
+    std::array<float, maxUnisonVoices> panGainR_B;
+    bool panGainsDirty = true;
+
+    // Pitch: glide, pitch bend and detune combined at control rate
+    PitchEngine pitchEngine;
+    int samplesUntilPitchUpdate = 0;
+
+    // Render one span with constant pitch targets: oscillators → mix → filter → amp envelope
+    void renderSegment(float* leftOut, float* rightOut, int numSamples,
+                       float* oscBuffer, float* oscBufferB, float* leftMix, float* rightMix,
+                       const float* positionLaneA, const float* positionLaneB)
+    {
+        // Refresh cached pan gains if pan, spread or unison count changed
+        if (panGainsDirty)
+            updatePanGains();
+
+        juce::FloatVectorOperations::clear(leftMix, numSamples);
+        juce::FloatVectorOperations::clear(rightMix, numSamples);
+
+        // Process each active unison voice, mixed with cached constant-power pan gains
+        // Osc B renders first: in FM (B) / RM (B) warp, each osc A unison voice is modulated by
+        // the osc B unison voice with the same index (same detune slot), block into block
+        for (int unisonIndex = 0; unisonIndex < unisonCount; ++unisonIndex)
+        {
+            unisonOscB[unisonIndex].renderBlock(oscBufferB, numSamples, positionLaneB);
+            juce::FloatVectorOperations::addWithMultiply(leftMix, oscBufferB, oscB_level * panGainL_B[unisonIndex], numSamples);
+            juce::FloatVectorOperations::addWithMultiply(rightMix, oscBufferB, oscB_level * panGainR_B[unisonIndex], numSamples);
+
+            unisonOscA[unisonIndex].renderBlock(oscBuffer, numSamples, positionLaneA, oscBufferB);
+            juce::FloatVectorOperations::addWithMultiply(leftMix, oscBuffer, oscA_level * panGainL_A[unisonIndex], numSamples);
+            juce::FloatVectorOperations::addWithMultiply(rightMix, oscBuffer, oscA_level * panGainR_A[unisonIndex], numSamples);
+        }
+
+        // Add sub oscillator (mono, centered - once per voice, not per unison voice)
+        if (sub_level > 0.0f)
+        {
+            subOsc.renderBlock(oscBuffer, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(leftMix, oscBuffer, sub_level, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(rightMix, oscBuffer, sub_level, numSamples);
+        }
+
+        // Add noise oscillator (stereo, same noise - once per voice)
+        if (noise_level > 0.0f)
+        {
+            noiseOsc.renderBlock(oscBuffer, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(leftMix, oscBuffer, noise_level, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(rightMix, oscBuffer, noise_level, numSamples);
+        }
+
+        // Normalize by unison count (sqrt keeps constant power) and apply velocity
+        float gain = velocity / std::sqrt(static_cast<float>(unisonCount));
+        juce::FloatVectorOperations::multiply(leftMix, gain, numSamples);
+        juce::FloatVectorOperations::multiply(rightMix, gain, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float left = leftMix[i];
+            float right = rightMix[i];
 
-    // Phase 3.6: Glide/Portamento
-    float targetFrequency = 0.0f; // Target frequency for glide
-    float glideCoefficient = 0.0f; // Exponential smoothing coefficient
-    bool glideActive = false; // Whether glide is currently active
+            // Process through filter (stereo: one envelope/coefficient update for both channels)
+            filter.processSampleStereo(left, right, midiNote);
 
-    // Calculate detune and pan factors for current unison count
-    void calculateDetuneFactors()
+            // Apply amp envelope AFTER filter (standard subtractive synthesis order)
+            float envValue = ampEnvelope.getNextSample();
+            leftOut[i] += left * envValue;
+            rightOut[i] += right * envValue;
+
+            // Check if envelope finished
+            if (inRelease && envValue < 0.0001f)
+            {
+                isActive = false;
+                break;
+            }
+        }
+    }
+
+    // Convert oscillator octave/semitone/fine-cents settings to a semitone offset
+    static float getTuneSemitones(int octave, int semitone, int fineCents)
+    {
+        return static_cast<float>(octave * 12 + semitone) + fineCents / 100.0f;
+    }
+
+    // Advance glide and push new phase increments to every oscillator, ramped over rampSamples
+    void updatePitch(int rampSamples)
+    {
+        pitchEngine.advance(rampSamples);
+
+        std::array<float, maxUnisonVoices> increments;
+
+        pitchEngine.getUnisonIncrements(oscA_tune, static_cast<float>(Wavetable::samplesPerFrame), unisonTable, increments.data());
+        for (int i = 0; i < maxUnisonVoices; ++i)
+            unisonOscA[i].setPhaseIncrementTarget(increments[i], rampSamples);
+
+        pitchEngine.getUnisonIncrements(oscB_tune, static_cast<float>(Wavetable::samplesPerFrame), unisonTable, increments.data());
+        for (int i = 0; i < maxUnisonVoices; ++i)
+            unisonOscB[i].setPhaseIncrementTarget(increments[i], rampSamples);
+
+        // Sub oscillator tracks the main pitch (without detune), offset by its octave setting
+        subOsc.setPhaseIncrementTarget(pitchEngine.getIncrement(12.0f * subOsc.getOctaveOffset(), juce::MathConstants<float>::twoPi),
+                                       rampSamples);
+    }
+
+    // Store an oscillator pan value, flagging the pan gain cache when it changes
+    void setOscPan(float& oscPan, float newPan)
     {
-        if (unisonCount == 1)
+        if (newPan != oscPan)
         {
-            // No unison: single voice, no detune, centered
-            detuneFactors[0] = 1.0f;
-            panFactors[0] = 0.0f;
-            return;
+            oscPan = newPan;
+            panGainsDirty = true;
         }
+    }
 
-        // Calculate symmetric detune spread
-        // Formula: detune = (voiceIndex / (unisonCount-1) - 0.5) * 2.0 * detuneAmount
-        // This creates symmetric spread: voice 0 at -detuneAmount, voice N-1 at +detuneAmount
+    // Recalculate constant-power pan gains for every active unison voice
+    void updatePanGains()
+    {
         for (int i = 0; i < unisonCount; ++i)
         {
-            // Symmetric offset: -0.5 to +0.5
-            float offset = (static_cast<float>(i) / (unisonCount - 1)) - 0.5f;
-
-            // Scale to detune range: -detuneAmount to +detuneAmount (in semitones)
-            float detuneSemitones = offset * 2.0f * detuneAmount;
+            // Calculate stereo panning for this unison voice
+            float unisonPan = unisonTable.panFactors[static_cast<size_t>(i)] * stereoSpread; // -1.0 to +1.0
 
-            // Convert semitones to frequency multiplier: freq × 2^(semitones/12)
-            detuneFactors[i] = std::pow(2.0f, detuneSemitones / 12.0f);
+            // Apply oscillator-specific panning FIRST, then unison stereo spread
+            // Convert pan from -1..1 to 0..1 range for constant-power law
+            float panA = juce::jlimit(0.0f, 1.0f, (oscA_pan + unisonPan + 1.0f) * 0.5f);
+            panGainL_A[i] = std::cos(panA * juce::MathConstants<float>::halfPi);
+            panGainR_A[i] = std::sin(panA * juce::MathConstants<float>::halfPi);
 
-            // Calculate stereo pan position for this unison voice
-            // Voice 0 far left (-1.0), Voice N-1 far right (+1.0)
-            panFactors[i] = offset * 2.0f; // -1.0 to +1.0
+            float panB = juce::jlimit(0.0f, 1.0f, (oscB_pan + unisonPan + 1.0f) * 0.5f);
+            panGainL_B[i] = std::cos(panB * juce::MathConstants<float>::halfPi);
+            panGainR_B[i] = std::sin(panB * juce::MathConstants<float>::halfPi);
         }
+
+        panGainsDirty = false;
     }
 };
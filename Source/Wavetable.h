@@ -1,18 +1,313 @@
 #pragma once
 #include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <cmath>
+#include <complex>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
-// Wavetable format: 256 frames × 2048 samples per frame (Serum-compatible)
+// Wavetable format: any number of frames (up to 256) of any power-of-two length (up to 2048)
+// Built-in tables are 256 frames × 2048 samples per frame (Serum-compatible)
+// Each frame also has per-octave band-limited mip levels (FFT harmonic truncation)
+// so high notes can read a version with no harmonics above Nyquist.
+// Tables are stored as 32-bit float by default; 16-bit fixed point is opt-in (see SampleFormat).
+// Built-in tables are mapped from the on-disk cache (or generated and cached) once per process
+// and sample format, on a background thread, and published atomically.
 class Wavetable
 {
 public:
-    static constexpr int numFrames = 256;
-    static constexpr int samplesPerFrame = 2048;
+    static constexpr int numFrames = 256;        // Built-in tables, and the most frames a table can have
+    static constexpr int samplesPerFrame = 2048; // Longest frame; oscillator phase runs 0 to 2048 for every table
 
-    using Frame = std::array<float, samplesPerFrame>;
-    using WavetableData = std::array<Frame, numFrames>;
+    // Mip levels: level k keeps harmonics below (samplesPerFrame / 2) >> k
+    // Level 0 is the original full-bandwidth frame
+    static constexpr int numMipLevels = 11;
+    static constexpr int minMipFrameLength = 64;
+
+    // Highest level an oscillator plays: the last one that still keeps the fundamental
+    // (the top level is DC only, which would silence notes above a quarter of the sample rate)
+    static constexpr int highestPlayedMipLevel = numMipLevels - 2;
+    static_assert(((samplesPerFrame / 2) >> highestPlayedMipLevel) == 2, "Top played level must keep harmonic 1");
+
+    // Frame length for a mip level of a 2048-sample table: 2x oversampled relative to its top harmonic
+    // Shorter tables use min(frame length, this)
+    static constexpr int getMipFrameLength(int level)
+    {
+        return level == 0 ? samplesPerFrame
+                          : std::max(minMipFrameLength, std::min(samplesPerFrame, (2 * samplesPerFrame) >> level));
+    }
+
+    // Choose the mip level for a phase increment (table samples per output sample)
+    // Level k's top harmonic stays below Nyquist while the increment is at most 2^k; above that
+    // at the highest played level, only the fundamental is left and it stays below Nyquist up to 1024
+    static int getMipLevel(float phaseIncrement)
+    {
+        int level = 0;
+        float maxIncrement = 1.0f;
+
+        while (level < highestPlayedMipLevel && phaseIncrement > maxIncrement)
+        {
+            ++level;
+            maxIncrement *= 2.0f;
+        }
+
+        return level;
+    }
+
+    // Sample storage: 32-bit float, or 16-bit fixed point scaled to the table's peak
+    // Int16 halves the footprint (2 MB -> 1 MB for level 0), so twice as many frames stay in cache
+    // when many unison oscillators read the same table; quantisation noise is around -96 dBFS
+    enum class SampleFormat
+    {
+        Float32 = 0,
+        Int16
+    };
+
+    // Built-in and user tables use the default unless a format is asked for (the plugin's
+    // wt_storage parameter selects Int16 for both)
+    static constexpr SampleFormat defaultSampleFormat = SampleFormat::Float32;
+
+    // One wavetable: band-limited mip levels of every frame (level 0 = original frames)
+    // Stored in a single aligned heap block: a fixed-size Header, then every level's samples,
+    // frame after frame. The header holds per-level lengths, index shifts and offsets, so
+    // frame lookup is a couple of table reads with no branches. Small tables only take the
+    // memory they need, and identical levels (short frames have fewer harmonics to remove)
+    // share storage. The block is position independent, so it is also the on-disk cache format:
+    // cached tables are memory-mapped read-only and used in place (see openMapped).
+    class Table
+    {
+    public:
+        static constexpr uint32_t magic = 0x42545743; // "CWTB"
+        static constexpr uint32_t version = 1;
+        static constexpr size_t alignment = 64; // Cache line, and enough for any SIMD width
+
+        // Block header (plain data, position independent - offsets are relative to the sample data)
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t numFrames;
+            uint32_t frameLength;  // Level 0 frame length (power of two)
+            uint32_t format;       // SampleFormat
+            float compactScale;    // Int16 -> float multiplier
+            uint32_t levelFrameLength[numMipLevels];
+            uint32_t levelIndexShift[numMipLevels]; // 0-2047 phase index -> level frame index
+            uint64_t levelOffset[numMipLevels];     // First sample of each level
+            uint64_t numSamples;                    // Stored samples, all levels
+        };
+
+        // Sample data starts at the first aligned offset after the header
+        static constexpr size_t headerSize = (sizeof(Header) + alignment - 1) / alignment * alignment;
+
+        // Allocate a table with its level layout filled in and samples zeroed (NOT real-time safe)
+        // frameLength must be a power of two between 2 and samplesPerFrame
+        static std::unique_ptr<Table> create(int frameCount, int frameLength, SampleFormat format)
+        {
+            jassert(frameCount >= 1 && frameCount <= Wavetable::numFrames);
+            jassert(juce::isPowerOfTwo(frameLength) && frameLength >= 2 && frameLength <= samplesPerFrame);
+
+            const Header header = makeHeader(frameCount, frameLength, format);
+            const uint64_t numSamples = header.numSamples;
+
+            std::unique_ptr<Table> table(new Table());
+            table->storage.reset(new uint8_t[headerSize + numSamples * getBytesPerSample(format) + alignment]());
+
+            // Align the block start (same approach as ScratchArena)
+            auto address = reinterpret_cast<std::uintptr_t>(table->storage.get());
+            auto misalignment = address % alignment;
+            table->block = table->storage.get() + (misalignment == 0 ? 0 : alignment - misalignment);
+
+            std::memcpy(table->block, &header, sizeof(Header));
+            table->header = reinterpret_cast<const Header*>(table->block);
+            table->sampleData = table->block + headerSize;
+            return table;
+        }
+
+        // Map a table file written by writeToFile, read-only (NOT real-time safe)
+        // Returns nullptr if the file is missing, truncated, from another format version, or
+        // its layout doesn't match what create() would produce. The samples stay in the OS page
+        // cache, shared with every other instance and process mapping the same file.
+        static std::unique_ptr<Table> openMapped(const juce::File& file)
+        {
+            auto mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+            auto* data = static_cast<uint8_t*>(mappedFile->getData());
+
+            // Mappings start on a page boundary, so this only fails if the OS does something odd
+            if (data == nullptr || mappedFile->getSize() < headerSize
+                || reinterpret_cast<std::uintptr_t>(data) % alignment != 0)
+                return nullptr;
+
+            Header header;
+            std::memcpy(&header, data, sizeof(Header));
+            if (!isValidHeader(header, mappedFile->getSize()))
+                return nullptr;
+
+            std::unique_ptr<Table> table(new Table());
+            table->block = data; // Never written: only built tables use the ForWriting accessors
+            table->header = reinterpret_cast<const Header*>(data);
+            table->sampleData = data + headerSize;
+            table->mappedFile = std::move(mappedFile);
+            return table;
+        }
+
+        // Write the block to a file for openMapped (NOT real-time safe)
+        // Goes through a temporary file and a rename, so other processes mapping or reading the
+        // target never see a partial file
+        bool writeToFile(const juce::File& file) const
+        {
+            if (!file.getParentDirectory().createDirectory())
+                return false;
+
+            juce::TemporaryFile temporaryFile(file);
+            return temporaryFile.getFile().replaceWithData(block, getBlockSize())
+                   && temporaryFile.overwriteTargetFileWithTemporary();
+        }
+
+        // Process-unique id, never reused (unlike the address of a freed table) - identifies the
+        // table in caches keyed on it, e.g. BlendedFrameCache
+        uint64_t getId() const noexcept { return id; }
+
+        int getNumFrames() const noexcept { return static_cast<int>(header->numFrames); }
+        SampleFormat getFormat() const noexcept { return static_cast<SampleFormat>(header->format); }
+        float getCompactScale() const noexcept { return header->compactScale; }
+
+        // Frame length of a mip level (power of two) and the phase index shift that reaches it
+        int getFrameLength(int level) const noexcept { return static_cast<int>(header->levelFrameLength[level]); }
+        int getIndexShift(int level) const noexcept { return static_cast<int>(header->levelIndexShift[level]); }
+
+        // Whole block (header + samples), e.g. for writing to disk
+        const void* getBlock() const noexcept { return block; }
+        size_t getBlockSize() const noexcept { return headerSize + static_cast<size_t>(header->numSamples) * getBytesPerSample(getFormat()); }
+
+        // Index of the first sample of a frame at a mip level (branch-free)
+        size_t getFrameOffset(int level, int frame) const noexcept
+        {
+            return static_cast<size_t>(header->levelOffset[level])
+                   + static_cast<size_t>(frame) * header->levelFrameLength[level];
+        }
+
+        // Frame data for a mip level (Float32 tables only)
+        const float* getFrame(int level, int frame) const noexcept
+        {
+            jassert(getFormat() == SampleFormat::Float32);
+            return reinterpret_cast<const float*>(sampleData) + getFrameOffset(level, frame);
+        }
+
+        // Frame data for a mip level (Int16 tables only, multiply by getCompactScale())
+        const int16_t* getCompactFrame(int level, int frame) const noexcept
+        {
+            jassert(getFormat() == SampleFormat::Int16);
+            return reinterpret_cast<const int16_t*>(sampleData) + getFrameOffset(level, frame);
+        }
+
+        // Single sample at a mip level, decoded to float (either format)
+        float getSample(int level, int frame, int index) const noexcept
+        {
+            size_t offset = getFrameOffset(level, frame) + static_cast<size_t>(index);
+
+            if (getFormat() == SampleFormat::Int16)
+                return static_cast<float>(reinterpret_cast<const int16_t*>(sampleData)[offset]) * header->compactScale;
+
+            return reinterpret_cast<const float*>(sampleData)[offset];
+        }
+
+        // Highest harmonic (exclusive) a level keeps for a given level-0 frame length
+        static int getLevelMaxHarmonic(int level, int frameLength)
+        {
+            return level == 0 ? frameLength / 2 + 1 : std::min(frameLength / 2, (samplesPerFrame / 2) >> level);
+        }
+
+    private:
+        friend class Wavetable;
+
+        Table() = default;
+
+        std::unique_ptr<uint8_t[]> storage;                 // Built tables own their block...
+        std::unique_ptr<juce::MemoryMappedFile> mappedFile; // ...cached tables map it
+        uint8_t* block = nullptr;      // Aligned start of the header
+        const Header* header = nullptr;
+        uint8_t* sampleData = nullptr; // Aligned start of the samples
+        const uint64_t id = getNextId();
+
+        static uint64_t getNextId() noexcept
+        {
+            static std::atomic<uint64_t> nextId { 1 }; // 0 = no table
+            return nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static size_t getBytesPerSample(SampleFormat format)
+        {
+            return format == SampleFormat::Int16 ? sizeof(int16_t) : sizeof(float);
+        }
+
+        // Header with the level layout for a table shape (compactScale left at 1)
+        static Header makeHeader(int frameCount, int frameLength, SampleFormat format)
+        {
+            Header header {};
+            header.magic = magic;
+            header.version = version;
+            header.numFrames = static_cast<uint32_t>(frameCount);
+            header.frameLength = static_cast<uint32_t>(frameLength);
+            header.format = static_cast<uint32_t>(format);
+            header.compactScale = 1.0f;
+
+            uint64_t numSamples = 0;
+            for (int level = 0; level < numMipLevels; ++level)
+            {
+                const int length = std::min(frameLength, getMipFrameLength(level));
+                header.levelFrameLength[level] = static_cast<uint32_t>(length);
+                header.levelIndexShift[level] = static_cast<uint32_t>(getFFTOrder(samplesPerFrame / length));
+
+                // A level that removes no more harmonics than the one before is the same data
+                if (level > 0 && getLevelMaxHarmonic(level, frameLength) == getLevelMaxHarmonic(level - 1, frameLength)
+                    && length == static_cast<int>(header.levelFrameLength[level - 1]))
+                {
+                    header.levelOffset[level] = header.levelOffset[level - 1];
+                    continue;
+                }
+
+                header.levelOffset[level] = numSamples;
+                numSamples += static_cast<uint64_t>(frameCount) * static_cast<uint64_t>(length);
+            }
+            header.numSamples = numSamples;
+
+            return header;
+        }
+
+        // A header read from disk is only trusted if it is exactly what create() would write
+        static bool isValidHeader(const Header& header, size_t blockSize)
+        {
+            if (header.magic != magic || header.version != version
+                || header.numFrames < 1 || header.numFrames > static_cast<uint32_t>(Wavetable::numFrames)
+                || header.frameLength < 2 || header.frameLength > static_cast<uint32_t>(samplesPerFrame)
+                || !juce::isPowerOfTwo(header.frameLength)
+                || header.format > static_cast<uint32_t>(SampleFormat::Int16)
+                || !std::isfinite(header.compactScale) || header.compactScale <= 0.0f)
+                return false;
+
+            const auto format = static_cast<SampleFormat>(header.format);
+            const Header expected = makeHeader(static_cast<int>(header.numFrames), static_cast<int>(header.frameLength), format);
+
+            return std::memcmp(header.levelFrameLength, expected.levelFrameLength, sizeof(expected.levelFrameLength)) == 0
+                   && std::memcmp(header.levelIndexShift, expected.levelIndexShift, sizeof(expected.levelIndexShift)) == 0
+                   && std::memcmp(header.levelOffset, expected.levelOffset, sizeof(expected.levelOffset)) == 0
+                   && header.numSamples == expected.numSamples
+                   && blockSize >= headerSize + static_cast<size_t>(header.numSamples) * getBytesPerSample(format);
+        }
+
+        Header& getHeaderForWriting() noexcept { return *reinterpret_cast<Header*>(block); }
+        float* getFrameForWriting(int level, int frame) noexcept { return reinterpret_cast<float*>(sampleData) + getFrameOffset(level, frame); }
+        int16_t* getCompactFrameForWriting(int level, int frame) noexcept { return reinterpret_cast<int16_t*>(sampleData) + getFrameOffset(level, frame); }
+
+        JUCE_DECLARE_NON_COPYABLE(Table)
+    };
 
     // Wavetable types
     enum class Type
@@ -24,26 +319,417 @@ public:
         Count
     };
 
-    // Get built-in wavetable by type
-    static const WavetableData& getWavetable(Type type)
+    using BuiltInTables = std::array<std::unique_ptr<Table>, static_cast<size_t>(Type::Count)>;
+
+    // Start generating the built-in tables in a sample format on a background thread (NOT real-time safe)
+    // Safe to call from any thread, any number of times - only the first call per format starts the
+    // build (a later call restarts it if cancelBuiltInTables() stopped it before it finished)
+    static void prepareBuiltInTables(SampleFormat format = defaultSampleFormat)
     {
-        static bool initialized = false;
-        if (!initialized)
+        getLoader(format).start();
+    }
+
+    // Block until the built-in tables are available, starting the build if needed (NOT real-time safe)
+    // Call before rendering that can't wait for the background build, e.g. prepareToPlay or offline bounces
+    static void waitForBuiltInTables(SampleFormat format = defaultSampleFormat)
+    {
+        getLoader(format).waitUntilReady();
+    }
+
+    // Stop unfinished background builds (every format) and join their threads (NOT real-time safe)
+    // Call while the plugin is shutting down, so no thread is left to join during static destruction
+    static void cancelBuiltInTables()
+    {
+        getLoader(SampleFormat::Float32).stop();
+        getLoader(SampleFormat::Int16).stop();
+    }
+
+    // Get built-in wavetable (with mip levels) by type, in a sample format
+    // Real-time safe: never blocks, returns nullptr until the background build has finished
+    static const Table* getTable(Type type, SampleFormat format = defaultSampleFormat) noexcept
+    {
+        auto* tables = getLoader(format).get();
+        return tables != nullptr ? (*tables)[static_cast<size_t>(type)].get() : nullptr;
+    }
+
+    // True once the built-in tables are available in a sample format
+    static bool areBuiltInTablesReady(SampleFormat format = defaultSampleFormat) noexcept
+    {
+        return getLoader(format).get() != nullptr;
+    }
+
+    // On-disk cache of prepared tables, one memory-mappable file per table
+    // Bump when the built-in generators change, so stale cached tables are not used
+    static constexpr int builtInTablesVersion = 1;
+
+    static juce::File getCacheDirectory()
+    {
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("Codox")
+            .getChildFile("WavetableCache");
+    }
+
+    // Cached table by name, mapped read-only, or nullptr if it isn't cached (NOT real-time safe)
+    static std::unique_ptr<Table> loadCachedTable(const juce::String& name)
+    {
+        auto file = getCacheDirectory().getChildFile(name + ".cwtb");
+        return file.existsAsFile() ? Table::openMapped(file) : nullptr;
+    }
+
+    // Save a prepared table for next time; failures only cost a rebuild later (NOT real-time safe)
+    static void storeCachedTable(const juce::String& name, const Table& table)
+    {
+        if (!table.writeToFile(getCacheDirectory().getChildFile(name + ".cwtb")))
+            juce::Logger::writeToLog("Could not cache wavetable: " + name);
+    }
+
+private:
+    // Builds the built-in tables in one sample format once and publishes them with an atomic pointer store
+    // The build checks a cancel flag between tables, so stop() returns quickly
+    class BuiltInLoader
+    {
+    public:
+        explicit BuiltInLoader(SampleFormat tableFormat) : format(tableFormat) {}
+
+        ~BuiltInLoader()
         {
-            initializeWavetables();
-            initialized = true;
+            stop();
+            delete published.load();
         }
 
-        return wavetables[static_cast<int>(type)];
+        void start()
+        {
+            const std::lock_guard<std::mutex> lock(workerLock);
+
+            if (get() != nullptr || worker.joinable())
+                return;
+
+            cancelled.store(false);
+            worker = std::thread([this]
+            {
+                auto tables = std::make_unique<BuiltInTables>();
+                if (initializeWavetables(*tables, format, cancelled))
+                    published.store(tables.release(), std::memory_order_release);
+            });
+        }
+
+        void waitUntilReady()
+        {
+            start();
+
+            const std::lock_guard<std::mutex> lock(workerLock);
+            if (worker.joinable())
+                worker.join();
+        }
+
+        void stop()
+        {
+            const std::lock_guard<std::mutex> lock(workerLock);
+
+            cancelled.store(true);
+            if (worker.joinable())
+                worker.join();
+        }
+
+        const BuiltInTables* get() const noexcept
+        {
+            return published.load(std::memory_order_acquire);
+        }
+
+    private:
+        const SampleFormat format;
+        std::mutex workerLock; // Guards worker (start, wait and stop may come from different threads)
+        std::thread worker;
+        std::atomic<bool> cancelled { false };
+        std::atomic<const BuiltInTables*> published { nullptr };
+    };
+
+    // Process-wide loader per sample format (function-local statics: thread-safe construction)
+    // A format's tables are only built once something asks for them
+    static BuiltInLoader& getLoader(SampleFormat format) noexcept
+    {
+        static BuiltInLoader floatLoader { SampleFormat::Float32 };
+        static BuiltInLoader compactLoader { SampleFormat::Int16 };
+        return format == SampleFormat::Int16 ? compactLoader : floatLoader;
+    }
+
+public:
+    // log2 of a power-of-two frame length
+    static int getFFTOrder(int length)
+    {
+        int order = 0;
+        while ((1 << order) < length)
+            ++order;
+        return order;
+    }
+
+    // Optional spectral clean-up applied per frame while the mip levels are built
+    // Built-in tables use none of it; imported tables use all of it
+    struct Processing
+    {
+        bool removeDC = false;   // Zero the DC bin (offsets thump when notes start and stop)
+        bool alignPhase = false; // Rotate each frame so its fundamental starts like a sine (frames morph without cancelling)
+        bool normalise = false;  // Scale the table so its full-bandwidth peak is 1
+    };
+
+    // Frames each preparation worker takes at a time (and the fewest frames worth a worker)
+    static constexpr int framesPerWorkerBatch = 16;
+
+    // Helper threads for buildTable, shared by everything that prepares tables
+    // Hold one with juce::SharedResourcePointer<Wavetable::PreparationPool>: the threads start
+    // with the first holder and are joined when the last one lets go (never at static destruction)
+    struct PreparationPool
+    {
+        juce::ThreadPool pool { juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+    };
+
+    // Build a table with band-limited mip levels from its frames (built-in and user tables)
+    // frames holds frameCount frames of frameLength samples (a power of two up to samplesPerFrame).
+    // Each frame is transformed once; each level is an inverse FFT of its truncated spectrum
+    // at the level's (shorter) frame length, which also decimates it.
+    // Frames are independent, so they are spread over this thread and the helpers' threads
+    // (see PreparationPool; nullptr = this thread only), each worker with its own FFTs.
+    static std::unique_ptr<Table> buildTable(const float* frames, int frameCount, int frameLength,
+                                             SampleFormat format = defaultSampleFormat,
+                                             juce::ThreadPool* helpers = nullptr)
+    {
+        return buildTable(frames, frameCount, frameLength, format, Processing(), helpers);
+    }
+
+    static std::unique_ptr<Table> buildTable(const float* frames, int frameCount, int frameLength,
+                                             SampleFormat format, Processing processing,
+                                             juce::ThreadPool* helpers = nullptr)
+    {
+        auto table = Table::create(frameCount, frameLength, format);
+
+        // Levels are built in float, then stored in the table's format
+        std::vector<float> samples(static_cast<size_t>(table->header->numSamples), 0.0f);
+
+        // Workers (this thread plus helper jobs) claim batches of frames until none are left
+        const int maxWorkers = 1 + (helpers != nullptr ? helpers->getNumThreads() : 0);
+        const int numWorkers = juce::jlimit(1, maxWorkers, frameCount / framesPerWorkerBatch);
+        std::atomic<int> nextFrame { 0 };
+
+        auto work = [&]
+        {
+            FramePreparer preparer(*table, processing);
+
+            for (;;)
+            {
+                const int first = nextFrame.fetch_add(framesPerWorkerBatch);
+                if (first >= frameCount)
+                    break;
+
+                for (int frame = first; frame < std::min(first + framesPerWorkerBatch, frameCount); ++frame)
+                    preparer.process(frames + static_cast<size_t>(frame) * static_cast<size_t>(frameLength), frame, samples.data());
+            }
+        };
+
+        std::vector<std::unique_ptr<FrameBatchJob>> helperJobs;
+        for (int i = 1; i < numWorkers; ++i)
+        {
+            helperJobs.push_back(std::make_unique<FrameBatchJob>(work));
+            helpers->addJob(helperJobs.back().get(), false);
+        }
+
+        work();
+
+        // Jobs a busy pool never got to are just dropped (no frames are left); running ones are waited for
+        for (auto& job : helperJobs)
+            helpers->removeJob(job.get(), false, -1);
+
+        // Level 0 frames are contiguous at the start of the table
+        if (processing.normalise)
+        {
+            const int numFullSamples = frameCount * frameLength;
+            auto range = juce::FloatVectorOperations::findMinAndMax(samples.data(), numFullSamples);
+            float peak = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
+
+            if (peak > 0.0f)
+                juce::FloatVectorOperations::multiply(samples.data(), 1.0f / peak, static_cast<int>(samples.size()));
+        }
+
+        if (format == SampleFormat::Float32)
+        {
+            std::copy(samples.begin(), samples.end(), table->getFrameForWriting(0, 0));
+            return table;
+        }
+
+        // Int16: scale so the table's peak (over all levels - band-limiting can overshoot) is full scale
+        auto range = juce::FloatVectorOperations::findMinAndMax(samples.data(), static_cast<int>(samples.size()));
+        float peak = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()), 1.0e-9f);
+
+        table->getHeaderForWriting().compactScale = peak / 32767.0f;
+
+        const float toFixed = 32767.0f / peak;
+        int16_t* dest = table->getCompactFrameForWriting(0, 0);
+        for (size_t i = 0; i < samples.size(); ++i)
+            dest[i] = static_cast<int16_t>(std::lround(samples[i] * toFixed));
+
+        return table;
     }
 
 private:
-    // Storage for 4 built-in wavetables (inline for header-only, C++17)
-    inline static std::array<WavetableData, static_cast<int>(Type::Count)> wavetables;
+    // A helper's share of buildTable's frames, run on a PreparationPool thread
+    class FrameBatchJob : public juce::ThreadPoolJob
+    {
+    public:
+        explicit FrameBatchJob(std::function<void()> workToRun)
+            : juce::ThreadPoolJob("Wavetable frames"), work(std::move(workToRun)) {}
 
-    // Generate built-in wavetables
-    static void initializeWavetables()
+        JobStatus runJob() override
+        {
+            work();
+            return jobHasFinished;
+        }
+
+    private:
+        std::function<void()> work;
+    };
+
+    // One worker's FFTs and scratch buffers for buildTable (never shared between threads)
+    // Writes every mip level of a frame into the float staging buffer at the table's offsets
+    class FramePreparer
+    {
+    public:
+        FramePreparer(const Table& tableToBuild, Processing processingToApply)
+            : table(tableToBuild),
+              processing(processingToApply),
+              frameLength(tableToBuild.getFrameLength(0)),
+              forwardFFT(getFFTOrder(frameLength)),
+              spectrum(static_cast<size_t>(2 * frameLength)),
+              levelData(static_cast<size_t>(2 * frameLength))
+        {
+            for (int level = 0; level < numMipLevels; ++level)
+                inverseFFTs[static_cast<size_t>(level)] = std::make_unique<juce::dsp::FFT>(getFFTOrder(table.getFrameLength(level)));
+        }
+
+        void process(const float* source, int frame, float* samples)
+        {
+            const auto& header = *table.header;
+            const bool modifiesFrame = processing.removeDC || processing.alignPhase;
+
+            // Forward transform of the full-bandwidth frame (interleaved re/im per bin)
+            std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+            std::copy(source, source + frameLength, spectrum.begin());
+            forwardFFT.performRealOnlyForwardTransform(spectrum.data());
+
+            if (processing.removeDC)
+                spectrum[0] = 0.0f;
+
+            if (processing.alignPhase)
+                alignPhase();
+
+            for (int level = 0; level < numMipLevels; ++level)
+            {
+                float* dest = samples + table.getFrameOffset(level, frame);
+
+                // Level 0 is the original frame, unless it was cleaned up in the spectrum
+                if (level == 0 && !modifiesFrame)
+                {
+                    std::copy(source, source + frameLength, dest);
+                    continue;
+                }
+
+                // Shares storage with the level before (nothing more to remove)
+                if (level > 0 && header.levelOffset[level] == header.levelOffset[level - 1])
+                    continue;
+
+                const int length = table.getFrameLength(level);
+                const int maxHarmonic = Table::getLevelMaxHarmonic(level, frameLength); // First removed harmonic
+                const float scale = length / static_cast<float>(frameLength);
+
+                // Keep DC and harmonics below maxHarmonic (conjugate-symmetric spectrum of size length)
+                std::fill(levelData.begin(), levelData.begin() + 2 * length, 0.0f);
+                levelData[0] = spectrum[0] * scale;
+
+                for (int h = 1; h < maxHarmonic; ++h)
+                {
+                    float re = spectrum[static_cast<size_t>(2 * h)] * scale;
+                    float im = spectrum[static_cast<size_t>(2 * h + 1)] * scale;
+
+                    levelData[static_cast<size_t>(2 * h)] = re;
+                    levelData[static_cast<size_t>(2 * h + 1)] = im;
+                    levelData[static_cast<size_t>(2 * (length - h))] = re;
+                    levelData[static_cast<size_t>(2 * (length - h) + 1)] = -im;
+                }
+
+                inverseFFTs[static_cast<size_t>(level)]->performRealOnlyInverseTransform(levelData.data());
+                std::copy(levelData.begin(), levelData.begin() + length, dest);
+            }
+        }
+
+    private:
+        const Table& table;
+        Processing processing;
+        int frameLength;
+        juce::dsp::FFT forwardFFT;
+        std::array<std::unique_ptr<juce::dsp::FFT>, numMipLevels> inverseFFTs;
+        std::vector<float> spectrum;
+        std::vector<float> levelData;
+
+        // Circularly shift the frame (a linear phase term per harmonic) so the fundamental's
+        // phase is a sine's (-pi/2); frames with almost no fundamental are left alone
+        void alignPhase()
+        {
+            const std::complex<float> fundamental(spectrum[2], spectrum[3]);
+            if (std::abs(fundamental) < 1.0e-3f * static_cast<float>(frameLength))
+                return;
+
+            const float shift = std::arg(fundamental) + juce::MathConstants<float>::halfPi;
+
+            for (int h = 1; h <= frameLength / 2; ++h)
+            {
+                const auto rotation = std::polar(1.0f, -shift * static_cast<float>(h));
+                const auto bin = std::complex<float>(spectrum[static_cast<size_t>(2 * h)], spectrum[static_cast<size_t>(2 * h + 1)]) * rotation;
+
+                spectrum[static_cast<size_t>(2 * h)] = bin.real();
+                spectrum[static_cast<size_t>(2 * h + 1)] = bin.imag();
+            }
+
+            // A real frame's Nyquist bin has no imaginary part
+            spectrum[static_cast<size_t>(frameLength + 1)] = 0.0f;
+        }
+    };
+
+    // Cache file name of a built-in table (generator version and sample format included)
+    static juce::String getBuiltInCacheName(size_t index, SampleFormat format)
     {
+        return "builtin-v" + juce::String(builtInTablesVersion) + "-" + juce::String(static_cast<int>(index))
+               + (format == SampleFormat::Int16 ? "-i16" : "-f32");
+    }
+
+    // Map the built-in tables from the cache, or generate (and cache) them if any are missing
+    // Returns false if cancelled before the tables were complete (nothing is cached then)
+    static bool initializeWavetables(BuiltInTables& tables, SampleFormat format, const std::atomic<bool>& cancelled)
+    {
+        bool allCached = true;
+        for (size_t i = 0; i < tables.size(); ++i)
+        {
+            tables[i] = loadCachedTable(getBuiltInCacheName(i, format));
+            allCached = allCached && tables[i] != nullptr && tables[i]->getFormat() == format;
+        }
+
+        if (allCached)
+            return true;
+
+        if (!generateWavetables(tables, format, cancelled))
+            return false;
+
+        for (size_t i = 0; i < tables.size(); ++i)
+            storeCachedTable(getBuiltInCacheName(i, format), *tables[i]);
+
+        return true;
+    }
+
+    // Generate built-in wavetables (returns false if cancelled part way)
+    static bool generateWavetables(BuiltInTables& tables, SampleFormat format, const std::atomic<bool>& cancelled)
+    {
+        // Full-resolution frames for every type (temporary - tables keep only their mip storage)
+        // frames[type][frame * samplesPerFrame + sample]
+        std::vector<std::vector<float>> frames(static_cast<size_t>(Type::Count),
+                                               std::vector<float>(static_cast<size_t>(numFrames * samplesPerFrame)));
+
         // BASIC WAVETABLE: Morphing from sine → saw → square → triangle
         // Frame 0-63: Sine → Saw
         // Frame 64-127: Saw → Square
@@ -90,7 +776,7 @@ private:
                     output = triangle * (1.0f - t) + sine * t;
                 }
 
-                wavetables[static_cast<int>(Type::Basic)][frame][sample] = output;
+                frames[static_cast<size_t>(Type::Basic)][static_cast<size_t>(frame * samplesPerFrame + sample)] = output;
             }
         }
 
@@ -125,7 +811,7 @@ private:
                     output = (phase / (2.0f * juce::MathConstants<float>::pi)) < pulseWidth ? 1.0f : -1.0f;
                 }
 
-                wavetables[static_cast<int>(Type::Analog)][frame][sample] = output;
+                frames[static_cast<size_t>(Type::Analog)][static_cast<size_t>(frame * samplesPerFrame + sample)] = output;
             }
         }
 
@@ -159,7 +845,7 @@ private:
                     output = quantizedPhase < juce::MathConstants<float>::pi ? 1.0f : -1.0f;
                 }
 
-                wavetables[static_cast<int>(Type::Digital)][frame][sample] = output;
+                frames[static_cast<size_t>(Type::Digital)][static_cast<size_t>(frame * samplesPerFrame + sample)] = output;
             }
         }
 
@@ -217,8 +903,21 @@ private:
                 output = fundamental * 0.3f + formant1 + formant2 + formant3;
                 output *= 0.3f; // Normalize to prevent clipping
 
-                wavetables[static_cast<int>(Type::Vocal)][frame][sample] = output;
+                frames[static_cast<size_t>(Type::Vocal)][static_cast<size_t>(frame * samplesPerFrame + sample)] = output;
             }
         }
+
+        // Band-limited mip levels for all built-in tables (the bulk of the work, so check between tables)
+        juce::SharedResourcePointer<PreparationPool> preparationPool;
+
+        for (size_t i = 0; i < tables.size(); ++i)
+        {
+            if (cancelled.load())
+                return false;
+
+            tables[i] = buildTable(frames[i].data(), numFrames, samplesPerFrame, format, &preparationPool->pool);
+        }
+
+        return true;
     }
 };
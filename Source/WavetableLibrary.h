@@ -0,0 +1,174 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Wavetable.h"
+
+// WavetableLibrary - Process-wide cache of user wavetables, keyed by file content hash
+// Every plugin instance (and every voice) loading the same file shares one immutable table.
+// Users hold a TableRef (shared, refcounted); the library keeps its own reference too, so a
+// table outlives its last user and a reload is instant. Unused tables are evicted least
+// recently used first once the library is over its memory budget. Tables in use are never
+// evicted, and nothing here runs on the audio thread (it only ever sees raw table pointers).
+class WavetableLibrary
+{
+public:
+    using TableRef = std::shared_ptr<const Wavetable::Table>;
+    using TableFactory = std::function<std::unique_ptr<Wavetable::Table>()>;
+
+    static constexpr size_t defaultMemoryBudget = 256 * 1024 * 1024; // 256 MB of user tables
+
+    // Process-wide library (function-local static: thread-safe construction)
+    static WavetableLibrary& getInstance()
+    {
+        static WavetableLibrary library;
+        return library;
+    }
+
+    // 64-bit FNV-1a hash of raw file content
+    static uint64_t hashContent(const void* data, size_t numBytes) noexcept
+    {
+        auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = 14695981039346656037ull;
+
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Shared table for a content hash, or nullptr if it is not in the library
+    TableRef find(uint64_t contentHash)
+    {
+        const juce::ScopedLock lock(entriesLock);
+
+        if (auto* entry = findEntry(contentHash))
+        {
+            entry->lastUsed = ++useCounter;
+            return entry->table;
+        }
+
+        return nullptr;
+    }
+
+    // Shared table for a content hash, creating it with factory on a miss (NOT real-time safe)
+    // factory runs without the lock held, so slow decodes don't stall other instances;
+    // if two instances race on the same content, the first table added wins
+    TableRef findOrCreate(uint64_t contentHash, const TableFactory& factory)
+    {
+        if (auto existing = find(contentHash))
+            return existing;
+
+        std::unique_ptr<Wavetable::Table> created = factory();
+        if (created == nullptr)
+            return nullptr;
+
+        TableRef result;
+        {
+            const juce::ScopedLock lock(entriesLock);
+
+            if (auto* entry = findEntry(contentHash))
+            {
+                entry->lastUsed = ++useCounter;
+                result = entry->table;
+            }
+            else
+            {
+                const size_t bytes = created->getBlockSize();
+                result = TableRef(std::move(created));
+                entries.push_back({ contentHash, result, bytes, ++useCounter });
+                memoryUsage += bytes;
+            }
+        }
+
+        trim();
+        return result;
+    }
+
+    // Memory the library may keep for unused tables (tables in use always stay)
+    void setMemoryBudget(size_t bytes)
+    {
+        {
+            const juce::ScopedLock lock(entriesLock);
+            memoryBudget = bytes;
+        }
+
+        trim();
+    }
+
+    size_t getMemoryBudget() const
+    {
+        const juce::ScopedLock lock(entriesLock);
+        return memoryBudget;
+    }
+
+    // Bytes held by all tables in the library, used or not
+    size_t getMemoryUsage() const
+    {
+        const juce::ScopedLock lock(entriesLock);
+        return memoryUsage;
+    }
+
+    // Evict unused tables, least recently used first, until usage is within the budget
+    // Called after every insertion; also call when users have dropped references
+    void trim()
+    {
+        std::vector<TableRef> evicted; // Destroyed after the lock is released
+
+        {
+            const juce::ScopedLock lock(entriesLock);
+
+            while (memoryUsage > memoryBudget)
+            {
+                auto oldest = entries.end();
+
+                for (auto it = entries.begin(); it != entries.end(); ++it)
+                {
+                    // use_count() == 1: only the library holds it (new users need the lock)
+                    if (it->table.use_count() == 1 && (oldest == entries.end() || it->lastUsed < oldest->lastUsed))
+                        oldest = it;
+                }
+
+                if (oldest == entries.end())
+                    break; // Everything left is in use
+
+                memoryUsage -= oldest->bytes;
+                evicted.push_back(std::move(oldest->table));
+                entries.erase(oldest);
+            }
+        }
+    }
+
+private:
+    WavetableLibrary() = default;
+
+    struct Entry
+    {
+        uint64_t contentHash;
+        TableRef table;
+        size_t bytes;
+        uint64_t lastUsed; // useCounter value at the last lookup (LRU order)
+    };
+
+    juce::CriticalSection entriesLock;
+    std::vector<Entry> entries; // Few enough entries that a linear scan beats a map
+    size_t memoryUsage = 0;
+    size_t memoryBudget = defaultMemoryBudget;
+    uint64_t useCounter = 0;
+
+    Entry* findEntry(uint64_t contentHash)
+    {
+        for (auto& entry : entries)
+            if (entry.contentHash == contentHash)
+                return &entry;
+
+        return nullptr;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(WavetableLibrary)
+};
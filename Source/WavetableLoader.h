@@ -0,0 +1,472 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include "Wavetable.h"
+#include "WavetableLibrary.h"
+
+// WavetableLoader - User wavetables imported from audio files (one slot per oscillator)
+// Decoding, resampling and table preparation run on a background thread (the spectral
+// work per frame is spread over the shared Wavetable::PreparationPool by buildTable).
+// Tables come from the process-wide WavetableLibrary, so every instance loading the same
+// file content shares one table, and files prepared before (in any session) are mapped
+// from the on-disk cache instead of being decoded again.
+// Finished tables are published with an atomic pointer swap; the table they replace is
+// retired and its reference only dropped (on the message thread) once the audio thread has
+// finished two more blocks, so the audio thread never blocks, allocates or frees.
+// While audio is stopped no blocks finish, so call releaseRetiredTables() when it stops.
+class WavetableLoader : private juce::Timer
+{
+public:
+    static constexpr int numSlots = 2; // 0: Osc A, 1: Osc B
+    static constexpr int minSourceFrameSize = 16;     // Shorter "frames" are not usable waveforms
+    static constexpr int maxSourceFrameSize = 65536;  // Guards against bogus clm chunks
+    static constexpr int importVersion = 1;           // Bump when decode() changes, so stale cached tables are not used
+
+    // tableFormat: sample storage for tables this loader prepares (Int16 halves their memory, see
+    // Wavetable::SampleFormat); instances asking for different formats don't share tables.
+    // Can be changed later with setFormat().
+    explicit WavetableLoader(Wavetable::SampleFormat tableFormat = Wavetable::defaultSampleFormat)
+        : format(tableFormat)
+    {
+        for (auto& slot : slots)
+            slot.store(nullptr);
+
+        startTimer(1000); // Reclaim retired tables once a second
+    }
+
+    ~WavetableLoader() override
+    {
+        stopTimer();
+
+        // Load jobs reference this instance: wait however long they take to see shouldExit()
+        pool.removeAllJobs(true, -1);
+
+        for (auto& slot : slots)
+            slot.store(nullptr);
+
+        // Drop this instance's references, then let the library evict what nobody uses
+        {
+            const juce::ScopedLock lock(stateLock);
+            slotTables = {};
+            retiredTables.clear();
+        }
+
+        WavetableLibrary::getInstance().trim();
+    }
+
+    // Load a wavetable file into a slot in the background (any non-audio thread)
+    // The slot keeps its current table until the new one is ready
+    void loadFile(int slot, const juce::File& file)
+    {
+        if (!juce::isPositiveAndBelow(slot, numSlots))
+            return;
+
+        const int request = ++requestCounters[static_cast<size_t>(slot)];
+
+        {
+            const juce::ScopedLock lock(stateLock);
+            requestedFiles[static_cast<size_t>(slot)] = file;
+        }
+
+        pool.addJob(new LoadJob(*this, slot, file, request, format.load()), true);
+
+        reclaimRetiredTables();
+    }
+
+    // Sample storage for tables loaded from now on (any non-audio thread)
+    // Files already requested are loaded again in the new format; the slots keep their
+    // current tables until then
+    void setFormat(Wavetable::SampleFormat newFormat)
+    {
+        if (format.exchange(newFormat) == newFormat)
+            return;
+
+        for (int slot = 0; slot < numSlots; ++slot)
+        {
+            juce::File file;
+            {
+                const juce::ScopedLock lock(stateLock);
+                file = requestedFiles[static_cast<size_t>(slot)];
+            }
+
+            if (file != juce::File())
+                loadFile(slot, file);
+        }
+    }
+
+    Wavetable::SampleFormat getFormat() const noexcept
+    {
+        return format.load();
+    }
+
+    // Go back to the built-in table selected by the oscillator's wavetable parameter
+    void clear(int slot)
+    {
+        if (!juce::isPositiveAndBelow(slot, numSlots))
+            return;
+
+        {
+            const juce::ScopedLock lock(stateLock);
+            requestedFiles[static_cast<size_t>(slot)] = juce::File();
+        }
+
+        publish(slot, nullptr, {}, ++requestCounters[static_cast<size_t>(slot)]);
+    }
+
+    // User table for a slot, or nullptr to use the built-in tables (audio thread, real-time safe)
+    // Load once per block: the pointer stays valid until audioBlockFinished() has been called twice
+    const Wavetable::Table* getTable(int slot) const noexcept
+    {
+        return slots[static_cast<size_t>(slot)].load(std::memory_order_acquire);
+    }
+
+    // Call at the end of every processBlock (audio thread, real-time safe)
+    void audioBlockFinished() noexcept
+    {
+        ++audioEpoch;
+    }
+
+    // Drop every retired table now, without waiting for audio blocks (NOT real-time safe)
+    // Only call while processBlock can't be running (e.g. from releaseResources): otherwise
+    // tables swapped out while audio is stopped stay allocated until playback resumes
+    void releaseRetiredTables()
+    {
+        reclaimRetiredTables(true);
+    }
+
+    // Path of the file loaded into a slot (empty when using a built-in table)
+    juce::String getFilePath(int slot) const
+    {
+        const juce::ScopedLock lock(stateLock);
+        return filePaths[static_cast<size_t>(slot)];
+    }
+
+    // Shared table for an audio file: looked up by content hash, decoded only on a miss (NOT real-time safe)
+    // helpers: threads to spread the table preparation over (see Wavetable::buildTable)
+    // job: if given, decoding stops (returning nullptr) once its shouldExit() is true
+    static WavetableLibrary::TableRef loadShared(const juce::File& file, Wavetable::SampleFormat format,
+                                                 juce::ThreadPool* helpers = nullptr,
+                                                 const juce::ThreadPoolJob* job = nullptr)
+    {
+        juce::MemoryBlock data;
+        if (!file.loadFileAsData(data))
+            return nullptr;
+
+        // The same file prepared in another sample format is a different table
+        const auto contentHash = WavetableLibrary::hashContent(data.getData(), data.getSize());
+        const auto tableHash = (contentHash ^ static_cast<uint64_t>(format)) * 1099511628211ull; // One more FNV-1a step
+
+        return WavetableLibrary::getInstance().findOrCreate(tableHash, [&data, contentHash, format, helpers, job]
+        {
+            // Prepared before (by any instance or process): map it from the on-disk cache
+            const auto cacheName = "user-v" + juce::String(importVersion) + "-" + juce::String::toHexString(static_cast<juce::int64>(contentHash))
+                                   + (format == Wavetable::SampleFormat::Int16 ? "-i16" : "-f32");
+            auto cached = Wavetable::loadCachedTable(cacheName);
+            if (cached != nullptr && cached->getFormat() == format)
+                return cached;
+
+            auto table = decode(data, format, helpers, job);
+            if (table != nullptr)
+                Wavetable::storeCachedTable(cacheName, *table);
+
+            return table;
+        });
+    }
+
+    // Decode audio file content into a wavetable with mip levels (NOT real-time safe)
+    // Serum-style files store their frame size in a "clm " chunk; otherwise frames are
+    // 2048 samples, or the whole file is one single-cycle frame if it is shorter than that.
+    // The table keeps the file's frame count (up to 256) and a power-of-two frame length
+    // (the source length rounded up, at most 2048), so small tables stay small.
+    static std::unique_ptr<Wavetable::Table> decode(const juce::MemoryBlock& data, Wavetable::SampleFormat format,
+                                                    juce::ThreadPool* helpers = nullptr,
+                                                    const juce::ThreadPoolJob* job = nullptr)
+    {
+        auto shouldStop = [job] { return job != nullptr && job->shouldExit(); };
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formatManager.createReaderFor(std::make_unique<juce::MemoryInputStream>(data, false)));
+        if (reader == nullptr || reader->numChannels == 0 || reader->lengthInSamples < minSourceFrameSize)
+            return nullptr;
+
+        // Frame size: clm chunk, else the table format's frame size, else one single-cycle frame
+        const auto lengthInSamples = reader->lengthInSamples;
+        juce::MemoryInputStream clmStream(data, false);
+        int frameSize = readClmFrameSize(clmStream);
+        if (frameSize <= 0)
+            frameSize = static_cast<int>(juce::jmin<juce::int64>(lengthInSamples, Wavetable::samplesPerFrame));
+
+        if (frameSize < minSourceFrameSize || frameSize > maxSourceFrameSize || frameSize > lengthInSamples)
+            return nullptr;
+
+        const int numSourceFrames = static_cast<int>(juce::jmin<juce::int64>(Wavetable::numFrames, lengthInSamples / frameSize));
+        const int numSamples = numSourceFrames * frameSize;
+        const int frameLength = juce::jmin(juce::nextPowerOfTwo(frameSize), Wavetable::samplesPerFrame);
+
+        // Read and mix down to mono
+        const int numChannels = static_cast<int>(reader->numChannels);
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        if (!reader->read(&buffer, 0, numSamples, 0, true, true))
+            return nullptr;
+
+        std::vector<float> mono(static_cast<size_t>(numSamples), 0.0f);
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::addWithMultiply(mono.data(), buffer.getReadPointer(channel),
+                                                         1.0f / static_cast<float>(numChannels), numSamples);
+
+        // Resample every source frame to the table's frame length
+        std::vector<float> frames(static_cast<size_t>(numSourceFrames * frameLength));
+        FrameResampler resampler(frameSize, frameLength);
+        for (int i = 0; i < numSourceFrames; ++i)
+        {
+            if (shouldStop())
+                return nullptr;
+
+            resampler.process(mono.data() + static_cast<size_t>(i * frameSize), frames.data() + static_cast<size_t>(i * frameLength));
+        }
+
+        // Remove DC, align frame phases and normalise to full scale while the mip levels are built
+        Wavetable::Processing processing;
+        processing.removeDC = true;
+        processing.alignPhase = true;
+        processing.normalise = true;
+
+        auto table = Wavetable::buildTable(frames.data(), numSourceFrames, frameLength, format, processing, helpers);
+        return shouldStop() ? nullptr : std::move(table);
+    }
+
+    // Frame size from a Serum "clm " chunk ("<!>2048 ..."), or 0 if there is none
+    static int readClmFrameSize(juce::InputStream& stream)
+    {
+        char chunkId[4];
+        if (stream.read(chunkId, 4) != 4 || std::memcmp(chunkId, "RIFF", 4) != 0)
+            return 0;
+
+        stream.readInt(); // RIFF size
+        if (stream.read(chunkId, 4) != 4 || std::memcmp(chunkId, "WAVE", 4) != 0)
+            return 0;
+
+        // Walk the chunk list (chunks are word aligned)
+        while (stream.read(chunkId, 4) == 4)
+        {
+            const auto chunkSize = static_cast<juce::int64>(static_cast<juce::uint32>(stream.readInt()));
+            const auto chunkStart = stream.getPosition();
+
+            if (std::memcmp(chunkId, "clm ", 4) == 0)
+            {
+                juce::MemoryBlock text;
+                stream.readIntoMemoryBlock(text, static_cast<juce::ssize_t>(juce::jmin<juce::int64>(chunkSize, 256)));
+
+                auto content = text.toString();
+                return content.startsWith("<!>") ? content.substring(3).getIntValue() : 0;
+            }
+
+            if (!stream.setPosition(chunkStart + chunkSize + (chunkSize & 1)))
+                break;
+        }
+
+        return 0;
+    }
+
+private:
+    // Resamples single-cycle frames from one length to another (the target is a power of two)
+    // Power-of-two sources are resampled in the frequency domain (exact, no aliasing);
+    // other lengths use cyclic linear interpolation
+    class FrameResampler
+    {
+    public:
+        FrameResampler(int sourceLength, int targetLength)
+            : length(sourceLength), newLength(targetLength)
+        {
+            if (length != newLength && juce::isPowerOfTwo(length))
+            {
+                forwardFFT = std::make_unique<juce::dsp::FFT>(Wavetable::getFFTOrder(length));
+                inverseFFT = std::make_unique<juce::dsp::FFT>(Wavetable::getFFTOrder(newLength));
+                spectrum.resize(static_cast<size_t>(2 * length));
+                resampled.resize(static_cast<size_t>(2 * newLength));
+            }
+        }
+
+        void process(const float* source, float* dest)
+        {
+            if (length == newLength)
+            {
+                std::copy(source, source + length, dest);
+            }
+            else if (forwardFFT != nullptr)
+            {
+                std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+                std::copy(source, source + length, spectrum.begin());
+                forwardFFT->performRealOnlyForwardTransform(spectrum.data());
+
+                // Copy harmonics that fit in both lengths, rebuilding the conjugate-symmetric half
+                const int numHarmonics = std::min(length, newLength) / 2;
+                const float scale = newLength / static_cast<float>(length);
+
+                std::fill(resampled.begin(), resampled.end(), 0.0f);
+                resampled[0] = spectrum[0] * scale;
+
+                for (int h = 1; h < numHarmonics; ++h)
+                {
+                    float re = spectrum[static_cast<size_t>(2 * h)] * scale;
+                    float im = spectrum[static_cast<size_t>(2 * h + 1)] * scale;
+
+                    resampled[static_cast<size_t>(2 * h)] = re;
+                    resampled[static_cast<size_t>(2 * h + 1)] = im;
+                    resampled[static_cast<size_t>(2 * (newLength - h))] = re;
+                    resampled[static_cast<size_t>(2 * (newLength - h) + 1)] = -im;
+                }
+
+                inverseFFT->performRealOnlyInverseTransform(resampled.data());
+                std::copy(resampled.begin(), resampled.begin() + newLength, dest);
+            }
+            else
+            {
+                const float step = length / static_cast<float>(newLength);
+
+                for (int i = 0; i < newLength; ++i)
+                {
+                    float position = i * step;
+                    int index1 = static_cast<int>(position);
+                    int index2 = (index1 + 1) % length;
+                    float frac = position - index1;
+
+                    dest[i] = source[index1] + frac * (source[index2] - source[index1]);
+                }
+            }
+        }
+
+    private:
+        int length;
+        int newLength;
+        std::unique_ptr<juce::dsp::FFT> forwardFFT;
+        std::unique_ptr<juce::dsp::FFT> inverseFFT;
+        std::vector<float> spectrum;
+        std::vector<float> resampled;
+    };
+
+    // One loadFile request: find or decode the table, then publish it (unless a newer request superseded it)
+    // Checks shouldExit() between frames, so the destructor's wait for it stays short
+    class LoadJob : public juce::ThreadPoolJob
+    {
+    public:
+        LoadJob(WavetableLoader& loaderToUse, int slotToLoad, const juce::File& fileToLoad, int requestNumber,
+                Wavetable::SampleFormat tableFormat)
+            : juce::ThreadPoolJob("Wavetable load"), loader(loaderToUse), slot(slotToLoad), file(fileToLoad),
+              request(requestNumber), format(tableFormat) {}
+
+        JobStatus runJob() override
+        {
+            auto table = loadShared(file, format, &loader.preparationPool->pool, this);
+
+            if (shouldExit())
+                return jobHasFinished;
+
+            if (table == nullptr)
+            {
+                juce::Logger::writeToLog("Could not load wavetable: " + file.getFullPathName());
+                return jobHasFinished;
+            }
+
+            loader.publish(slot, std::move(table), file.getFullPathName(), request);
+            return jobHasFinished;
+        }
+
+    private:
+        WavetableLoader& loader;
+        const int slot;
+        const juce::File file;
+        const int request;
+        const Wavetable::SampleFormat format;
+    };
+
+    // A replaced table, kept alive until the audio thread can no longer be reading it
+    struct RetiredTable
+    {
+        WavetableLibrary::TableRef table;
+        juce::uint64 retiredAtEpoch;
+    };
+
+    std::array<std::atomic<const Wavetable::Table*>, numSlots> slots; // What the audio thread reads
+    std::array<std::atomic<int>, numSlots> requestCounters {};
+    std::atomic<juce::uint64> audioEpoch { 0 }; // Audio blocks finished
+
+    juce::CriticalSection stateLock; // Guards slotTables, filePaths, requestedFiles and retiredTables (never taken on the audio thread)
+    std::array<WavetableLibrary::TableRef, numSlots> slotTables; // Keep the published tables referenced
+    std::array<juce::String, numSlots> filePaths;
+    std::array<juce::File, numSlots> requestedFiles; // Latest loadFile per slot (published or not), for setFormat
+    std::vector<RetiredTable> retiredTables;
+
+    std::atomic<Wavetable::SampleFormat> format;
+    // Must stay declared before pool: members are destroyed in reverse order, so the preparation
+    // threads load jobs use are only released after pool has stopped those jobs
+    juce::SharedResourcePointer<Wavetable::PreparationPool> preparationPool;
+    juce::ThreadPool pool { 1 }; // One worker: loads finish in the order they were requested
+
+    // Swap a new table (or nullptr) into a slot and retire the previous one
+    void publish(int slot, WavetableLibrary::TableRef table, const juce::String& path, int request)
+    {
+        const juce::ScopedLock lock(stateLock);
+        const auto index = static_cast<size_t>(slot);
+
+        // A newer load or clear for this slot supersedes this one
+        if (request != requestCounters[index].load())
+            return;
+
+        slots[index].store(table.get(), std::memory_order_release);
+        std::swap(slotTables[index], table);
+        filePaths[index] = path;
+
+        // The audio thread may have loaded the previous table during the block it is in now
+        if (table != nullptr)
+            retiredTables.push_back({ std::move(table), audioEpoch.load() });
+    }
+
+    // Release retired tables once two audio blocks have finished since they were swapped out
+    // (or all of them, when the caller knows the audio thread isn't running)
+    void reclaimRetiredTables(bool audioStopped = false)
+    {
+        std::vector<RetiredTable> reclaimed;
+
+        {
+            const juce::ScopedLock lock(stateLock);
+            const auto epoch = audioEpoch.load();
+
+            for (auto it = retiredTables.begin(); it != retiredTables.end();)
+            {
+                if (audioStopped || epoch >= it->retiredAtEpoch + 2)
+                {
+                    reclaimed.push_back(std::move(*it));
+                    it = retiredTables.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        // reclaimed drops its references here, outside the lock; tables nobody else uses go
+        // back to the library, which evicts them once it is over its memory budget
+        if (!reclaimed.empty())
+        {
+            reclaimed.clear();
+            WavetableLibrary::getInstance().trim();
+        }
+    }
+
+    void timerCallback() override
+    {
+        reclaimRetiredTables();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(WavetableLoader)
+};
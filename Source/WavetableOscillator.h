@@ -1,27 +1,54 @@
 #pragma once
 #include "Wavetable.h"
+#include "BlendedFrameCache.h"
+#include "MinBlep.h"
 #include <cmath>
+#include <cstdint>
 
 // Wavetable oscillator with frame interpolation and warp modes
+// Reads the band-limited mip level matching its pitch, so high notes don't alias,
+// with linear, cubic or Hermite interpolation between samples within a frame.
+// Phase is a uint32 fraction of a cycle: it wraps for free on overflow, never drifts, and
+// the table index and fraction at any mip level are bit-field extracts.
 class WavetableOscillator
 {
 public:
     WavetableOscillator()
     {
-        currentWavetable = &Wavetable::getWavetable(Wavetable::Type::Basic);
+        // No table until the first setWavetable() (the plugin prepares the built-in tables in the
+        // sample format it uses - see Wavetable::prepareBuiltInTables)
+        updateFrameMorph();
     }
 
-    // Set wavetable type
-    void setWavetable(int wavetableIndex)
+    // Set wavetable type and storage format (outputs silence until those built-in tables are ready)
+    void setWavetable(int wavetableIndex, Wavetable::SampleFormat format = Wavetable::defaultSampleFormat)
     {
         wavetableIndex = juce::jlimit(0, static_cast<int>(Wavetable::Type::Count) - 1, wavetableIndex);
-        currentWavetable = &Wavetable::getWavetable(static_cast<Wavetable::Type>(wavetableIndex));
+        currentTable = Wavetable::getTable(static_cast<Wavetable::Type>(wavetableIndex), format);
+        updateFrameMorph();
     }
 
-    // Set frame position (0.0 to 1.0 → frame 0 to 255)
+    // Use a user wavetable (see WavetableLoader); the caller keeps it alive while it is in use
+    void setWavetable(const Wavetable::Table* table)
+    {
+        currentTable = table;
+        updateFrameMorph();
+    }
+
+    // Share a voice's blended-frame cache (nullptr = always read two frames)
+    void setFrameCache(BlendedFrameCache* cache)
+    {
+        frameCache = cache;
+    }
+
+    const Wavetable::Table* getWavetable() const { return currentTable; }
+    float getPosition() const { return position; }
+
+    // Set frame position (0.0 to 1.0 → first to last frame of the table)
     void setPosition(float pos)
     {
         position = juce::jlimit(0.0f, 1.0f, pos);
+        updateFrameMorph();
     }
 
     // Set pitch (note frequency with octave/semitone/fine tuning)
@@ -37,63 +64,196 @@ public:
         float fineMultiplier = std::pow(2.0f, fineCents / 1200.0f);
 
         // Combined frequency
-        frequency = baseFreq * octaveMultiplier * semitoneMultiplier * fineMultiplier;
+        float frequency = baseFreq * octaveMultiplier * semitoneMultiplier * fineMultiplier;
 
         // Calculate phase increment
-        phaseIncrement = (frequency / static_cast<float>(sampleRate)) * Wavetable::samplesPerFrame;
+        setPhaseIncrementTarget((frequency / static_cast<float>(sampleRate)) * Wavetable::samplesPerFrame, 0);
     }
 
-    // Set warp mode and amount (Phase 3.2c implementation - not yet active)
+    // Ramp the phase increment (table samples per output sample) linearly to target over
+    // rampSamples (0 = jump immediately)
+    // Used by the voice's control-rate PitchEngine for glitch-free glide, bend and detune
+    void setPhaseIncrementTarget(float targetIncrement, int rampSamples)
+    {
+        // Pick the mip level for the higher end of the ramp so nothing aliases on the way
+        const float currentIncrement = static_cast<float>(phaseIncrement) * (1.0f / phaseUnitsPerSample);
+        setMipLevel(Wavetable::getMipLevel(std::max(currentIncrement, targetIncrement)));
+
+        rampTarget = toPhaseUnits(static_cast<double>(targetIncrement) * phaseUnitsPerSample);
+
+        if (rampSamples <= 0)
+        {
+            phaseIncrement = rampTarget;
+            incrementStep = 0;
+            rampSamplesRemaining = 0;
+            return;
+        }
+
+        incrementStep = static_cast<int32_t>((static_cast<int64_t>(rampTarget) - static_cast<int64_t>(phaseIncrement)) / rampSamples);
+        rampSamplesRemaining = rampSamples;
+    }
+
+    // Intra-frame interpolation between table samples
+    enum class Interpolation
+    {
+        Linear = 0, // 2-point
+        Cubic,      // 4-point, 3rd-order Lagrange
+        Hermite     // 4-point, 3rd-order Hermite (Catmull-Rom)
+    };
+
+    void setInterpolation(int mode)
+    {
+        interpolation = static_cast<Interpolation>(juce::jlimit(0, 2, mode));
+    }
+
+    // Set warp mode and amount
+    enum WarpMode
+    {
+        Sync = 0,
+        BendPlus,
+        FM,
+        AM,
+        PWM,
+        FMFromB,    // Cross-modulation: a modulator block (osc B) shifts the read phase
+        RMFromB     // Cross-modulation: a modulator block (osc B) multiplies the output
+    };
+
     void setWarpMode(int mode)
     {
-        warpMode = juce::jlimit(0, 4, mode); // 0-4: Sync, Bend+, FM, AM, PWM
+        mode = juce::jlimit(0, 6, mode); // 0-6: Sync, Bend+, FM, AM, PWM, FM (B), RM (B)
+        if (mode != warpMode)
+            syncBlep.clear(); // Drop sync corrections no longer mixed in
+
+        warpMode = mode;
+    }
+
+    // True when the warp mode needs a modulator block (see renderBlock with a modulator)
+    bool usesCrossModulation() const
+    {
+        return (warpMode == FMFromB || warpMode == RMFromB) && warpAmount >= 0.001f;
     }
 
     void setWarpAmount(float amount)
     {
-        warpAmount = juce::jlimit(0.0f, 1.0f, amount);
+        amount = juce::jlimit(0.0f, 1.0f, amount);
+        if (amount < 0.001f && warpAmount >= 0.001f)
+            syncBlep.clear(); // Warp off: the sync kernel won't consume pending corrections
+
+        warpAmount = amount;
     }
 
     // Reset phase
     void reset()
     {
-        phase = 0.0f;
-        syncPhase = 0.0f;
+        phase = 0;
+        syncPhase = 0;
+        syncBlep.clear();
+        incrementStep = 0;
+        rampSamplesRemaining = 0;
     }
 
     // Get next sample (with frame interpolation)
     float getNextSample()
     {
-        if (currentWavetable == nullptr)
+        if (currentTable == nullptr)
             return 0.0f;
 
-        // Calculate frame index from position (0.0 to 1.0 → 0 to 255)
-        float frameIndexFloat = position * (Wavetable::numFrames - 1);
-        int frame1 = static_cast<int>(frameIndexFloat);
-        int frame2 = std::min(frame1 + 1, Wavetable::numFrames - 1);
-        float frameFrac = frameIndexFloat - frame1; // Fractional part for interpolation
-
-        // Get sample index within frame
-        int sampleIndex = static_cast<int>(phase) % Wavetable::samplesPerFrame;
-
-        // Read samples from both frames
-        float sample1 = (*currentWavetable)[frame1][sampleIndex];
-        float sample2 = (*currentWavetable)[frame2][sampleIndex];
-
-        // Linear interpolation between frames
-        float output = sample1 + frameFrac * (sample2 - sample1);
+        // Read the table at the current phase (interpolated, morphed between frames)
+        float output = readTable(phase);
 
-        // Advance phase
+        // Advance phase (wraps on overflow) and pitch ramp
         phase += phaseIncrement;
-        if (phase >= Wavetable::samplesPerFrame)
-            phase -= Wavetable::samplesPerFrame;
+        advanceRamp();
 
-        // Apply warp modes (Phase 3.2c - placeholder for now, returns unmodified output)
+        // Apply warp modes
         output = applyWarp(output);
 
         return output;
     }
 
+    // Render numSamples into out (pitch ramps continue across the block)
+    void renderBlock(float* out, int numSamples)
+    {
+        // Static position: read the voice's pre-blended frame (one read per sample instead of two)
+        blendedFrame = (frameCache != nullptr) ? frameCache->getFrame(currentTable, position, mipLevel) : nullptr;
+
+        if (currentTable == nullptr)
+        {
+            juce::FloatVectorOperations::clear(out, numSamples);
+        }
+        else if (warpAmount >= 0.001f)
+        {
+            // Warp modes read and move the phase per sample: one specialised kernel per mode,
+            // chosen once per block
+            (this->*getWarpRenderer(warpMode))(out, numSamples);
+        }
+        else
+        {
+            for (int start = 0; start < numSamples; start += renderChunkSize)
+                renderChunk(out + start, juce::jmin(renderChunkSize, numSamples - start));
+        }
+
+        blendedFrame = nullptr;
+    }
+
+    // Render numSamples with a per-sample position (0.0 to 1.0) lane, e.g. from an LFO or envelope
+    // (nullptr = the current position). A lane holding one value renders exactly like
+    // renderBlock() at that position, blended-frame cache included; a moving lane morphs
+    // per sample. The oscillator is left at the lane's last position.
+    void renderBlock(float* out, int numSamples, const float* positionLane)
+    {
+        if (positionLane == nullptr || numSamples <= 0)
+        {
+            renderBlock(out, numSamples);
+            return;
+        }
+
+        auto range = juce::FloatVectorOperations::findMinAndMax(positionLane, numSamples);
+        if (range.getStart() == range.getEnd())
+        {
+            setPosition(range.getStart());
+            renderBlock(out, numSamples);
+            return;
+        }
+
+        if (currentTable == nullptr)
+        {
+            juce::FloatVectorOperations::clear(out, numSamples);
+        }
+        else if (warpAmount >= 0.001f)
+        {
+            // Warp kernels hold the position for their block, so feed them one sample at a time
+            const auto renderer = getWarpRenderer(warpMode);
+            const float* modulator = crossModulator;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                setPosition(positionLane[i]);
+                crossModulator = modulator != nullptr ? modulator + i : nullptr;
+                (this->*renderer)(out + i, 1);
+            }
+            crossModulator = modulator;
+        }
+        else
+        {
+            for (int start = 0; start < numSamples; start += renderChunkSize)
+                renderChunk(out + start, juce::jmin(renderChunkSize, numSamples - start), positionLane + start);
+        }
+
+        setPosition(positionLane[numSamples - 1]);
+    }
+
+    // Render numSamples cross-modulated by another oscillator's rendered block (numSamples long)
+    // FM (B) adds modulator * depth to the read phase (through-zero: negative values read
+    // backwards), RM (B) multiplies by the modulator. Other warp modes ignore the modulator.
+    // The whole modulator block is already rendered, so this costs one extra read per sample
+    // at most, with no per-sample calls between oscillators.
+    void renderBlock(float* out, int numSamples, const float* positionLane, const float* modulator)
+    {
+        crossModulator = modulator;
+        renderBlock(out, numSamples, positionLane);
+        crossModulator = nullptr;
+    }
+
     // Get next sample with custom position (for morphing automation)
     float getNextSampleWithPosition(float pos)
     {
@@ -102,169 +262,512 @@ public:
     }
 
 private:
-    const Wavetable::WavetableData* currentWavetable = nullptr;
-    float phase = 0.0f;
-    float phaseIncrement = 0.0f;
-    float frequency = 440.0f;
+    static constexpr int renderChunkSize = 64; // Samples gathered before the vectorized decode/morph/interpolate
+    static constexpr int maxInterpolationPoints = 4;
+
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static constexpr int numLanes = static_cast<int>(Lanes::SIMDNumElements);
+    static_assert(renderChunkSize % numLanes == 0, "Chunks must be a whole number of SIMD registers");
+
+    // Phase units: 2^32 per cycle, so 2^21 per level-0 table sample (2048-sample cycle)
+    static constexpr int phaseFractionBits = 21;
+    static constexpr float phaseUnitsPerSample = static_cast<float>(1 << phaseFractionBits);
+    static_assert((static_cast<uint64_t>(Wavetable::samplesPerFrame) << phaseFractionBits) == (uint64_t { 1 } << 32),
+                  "One cycle must be exactly 2^32 phase units");
+
+    const Wavetable::Table* currentTable = nullptr;
+    BlendedFrameCache* frameCache = nullptr; // Shared by the voice's unison oscillators
+    const float* blendedFrame = nullptr; // Cached morphed frame at mipLevel (set during renderBlock only)
+    int mipLevel = 0; // Band-limited version of the table in use
+    uint32_t phase = 0;          // Fraction of a cycle (2^32 = one cycle)
+    uint32_t phaseIncrement = 0; // Phase units per sample
+    uint32_t rampTarget = 0;     // Increment the ramp ends on (exactly, whatever the step rounding)
+    int32_t incrementStep = 0;   // Per-sample increment change while ramping
+    int rampSamplesRemaining = 0;
     float position = 0.0f; // 0.0 to 1.0
+    int morphFrame1 = 0;    // Frames either side of position, and the blend between them
+    int morphFrame2 = 0;    // (updated when the position or table changes, not per read)
+    float morphFrac = 0.0f;
+    Interpolation interpolation = Interpolation::Linear;
 
-    // Warp parameters (Phase 3.2c - implemented)
-    int warpMode = 0; // 0: Sync, 1: Bend+, 2: FM, 3: AM, 4: PWM
+    // Warp parameters
+    int warpMode = 0; // 0: Sync, 1: Bend+, 2: FM, 3: AM, 4: PWM, 5: FM (B), 6: RM (B)
     float warpAmount = 0.0f;
-    float syncPhase = 0.0f; // Sync oscillator phase (for hard sync mode)
+    uint32_t syncPhase = 0; // Sync oscillator phase (for hard sync mode)
+    MinBlepBuffer syncBlep; // Band-limiting corrections for the sync resets
+    const float* crossModulator = nullptr; // Modulator block for FM (B) / RM (B) (set during renderBlock only)
 
-    // Apply warp mode processing (Phase 3.2c - implemented)
-    float applyWarp(float sample)
+    void setMipLevel(int level)
     {
-        if (warpAmount < 0.001f)
-            return sample; // No warp applied
-
-        switch (warpMode)
-        {
-            case 0: // Sync - Hard sync with phase resets
-                return applySync(sample);
+        mipLevel = level;
+    }
 
-            case 1: // Bend+ - Asymmetric phase distortion (compress first half)
-                return applyBendPlus(sample);
+    // Frames either side of the position (0.0 to 1.0 → first to last frame) and the blend
+    void updateFrameMorph()
+    {
+        if (currentTable == nullptr)
+            return;
+
+        const int lastFrame = currentTable->getNumFrames() - 1;
+        float frameIndexFloat = position * lastFrame;
+        morphFrame1 = static_cast<int>(frameIndexFloat);
+        morphFrame2 = std::min(morphFrame1 + 1, lastFrame);
+        morphFrac = frameIndexFloat - morphFrame1; // Fractional part for interpolation
+    }
 
-            case 2: // FM - Frequency modulation (self-modulation for now)
-                return applyFM(sample);
+    // Phase units from a (possibly out of range) real value, saturating instead of wrapping
+    static uint32_t toPhaseUnits(double units)
+    {
+        return static_cast<uint32_t>(juce::jlimit(0.0, 4294967295.0, units));
+    }
 
-            case 3: // AM - Amplitude modulation (self-modulation creates ring mod effect)
-                return applyAM(sample);
+    // Phase from a position within the cycle (0.0 to 1.0)
+    static uint32_t toPhase(float cyclePosition)
+    {
+        return toPhaseUnits(static_cast<double>(cyclePosition) * 4294967296.0);
+    }
 
-            case 4: // PWM - Pulse width modulation
-                return applyPWM(sample);
+    // Position within the cycle (0.0 to 1.0) of a phase
+    static float toCyclePosition(uint32_t tablePhase)
+    {
+        return static_cast<float>(tablePhase) * (1.0f / 4294967296.0f);
+    }
 
-            default:
-                return sample;
-        }
+    // Bits of phase below one sample of the current mip level (its index is the bits above)
+    int getIndexShift() const
+    {
+        return phaseFractionBits + currentTable->getIndexShift(mipLevel);
     }
 
-    // Warp mode implementations
-    float applySync(float sample)
+    // Interpolation fraction: the top 24 bits below the index, scaled to 0.0-1.0
+    static float getFraction(uint32_t tablePhase, int indexShift)
     {
-        // Hard sync: Phase resets at warp_amount frequency
-        // Higher warp amount = more frequent resets = more harmonics
-        float syncFreq = frequency * (1.0f + warpAmount * 4.0f); // Up to 5x base frequency
-        float syncPhaseIncrement = (syncFreq / static_cast<float>(getSampleRate())) * Wavetable::samplesPerFrame;
+        return static_cast<float>((tablePhase << (32 - indexShift)) >> 8) * (1.0f / 16777216.0f);
+    }
 
-        syncPhase += syncPhaseIncrement;
-        if (syncPhase >= Wavetable::samplesPerFrame)
+    void advanceRamp()
+    {
+        if (rampSamplesRemaining > 0)
         {
-            syncPhase -= Wavetable::samplesPerFrame;
-            phase = 0.0f; // Reset main oscillator phase (hard sync)
+            phaseIncrement += static_cast<uint32_t>(incrementStep);
+            if (--rampSamplesRemaining == 0)
+                phaseIncrement = rampTarget;
         }
+    }
 
-        return sample;
+    // Interpolation kernels over 4 neighbouring points p0..p3 (p1 at the read position, fraction f)
+    // Written once for float and SIMD lanes: scalar constants always go on the right
+    template <typename T>
+    static T interpolateLinear(T p1, T p2, T f)
+    {
+        return p1 + (p2 - p1) * f;
     }
 
-    float applyBendPlus(float sample)
+    template <typename T>
+    static T interpolateCubic(T p0, T p1, T p2, T p3, T f)
     {
-        // Bend+: Asymmetric phase distortion (compress first half of waveform)
-        // This stretches the waveform, shifting harmonics upward
-        float phaseNormalized = phase / Wavetable::samplesPerFrame; // 0.0 to 1.0
+        T c1 = p2 - p0 * (1.0f / 3.0f) - p1 * 0.5f - p3 * (1.0f / 6.0f);
+        T c2 = (p0 + p2) * 0.5f - p1;
+        T c3 = (p3 - p0) * (1.0f / 6.0f) + (p1 - p2) * 0.5f;
+        return ((c3 * f + c2) * f + c1) * f + p1;
+    }
 
-        // Apply non-linear phase warping (compress first half based on warp amount)
-        float bendFactor = 1.0f + warpAmount * 2.0f; // 1.0 to 3.0
-        float warpedPhase = phaseNormalized;
+    template <typename T>
+    static T interpolateHermite(T p0, T p1, T p2, T p3, T f)
+    {
+        T c1 = (p2 - p0) * 0.5f;
+        T c2 = p0 - p1 * 2.5f + p2 * 2.0f - p3 * 0.5f;
+        T c3 = (p3 - p0) * 0.5f + (p1 - p2) * 1.5f;
+        return ((c3 * f + c2) * f + c1) * f + p1;
+    }
 
-        if (phaseNormalized < 0.5f)
+    // First and last of the 4 neighbouring points the current interpolation needs
+    int getFirstPoint() const { return interpolation == Interpolation::Linear ? 1 : 0; }
+    int getLastPoint() const { return interpolation == Interpolation::Linear ? 2 : 3; }
+
+    // One table sample at the mip level's resolution, morphed between the two frames at position
+    float readPoint(int mipIndex) const
+    {
+        if (blendedFrame != nullptr)
+            return blendedFrame[mipIndex];
+
+        float sample1 = currentTable->getSample(mipLevel, morphFrame1, mipIndex);
+        float sample2 = currentTable->getSample(mipLevel, morphFrame2, mipIndex);
+
+        // Linear interpolation between frames
+        return sample1 + morphFrac * (sample2 - sample1);
+    }
+
+    // Read the table at a phase, interpolated within the frame
+    float readTable(uint32_t tablePhase) const
+    {
+        const int mask = currentTable->getFrameLength(mipLevel) - 1;
+        const int indexShift = getIndexShift();
+        const int index = static_cast<int>(tablePhase >> indexShift);
+        const float frac = getFraction(tablePhase, indexShift);
+
+        float p1 = readPoint(index & mask);
+        float p2 = readPoint((index + 1) & mask);
+
+        if (interpolation == Interpolation::Linear)
+            return interpolateLinear(p1, p2, frac);
+
+        float p0 = readPoint((index - 1) & mask);
+        float p3 = readPoint((index + 2) & mask);
+
+        return interpolation == Interpolation::Cubic ? interpolateCubic(p0, p1, p2, p3, frac)
+                                                     : interpolateHermite(p0, p1, p2, p3, frac);
+    }
+
+    // Where each sample of a chunk reads its two frames (sample offsets from the level's
+    // first frame) and how far it blends between them
+    struct ChunkFrames
+    {
+        int offset1[renderChunkSize];
+        int offset2[renderChunkSize];
+        alignas(32) float fraction[renderChunkSize]; // Only filled for a per-sample position
+        bool perSample = false;
+    };
+
+    // Block version of getNextSample() without warp, in three passes:
+    // phase (indices + fractions), gather (neighbouring points, decoded and morphed with
+    // FloatVectorOperations), then the interpolation kernel on SIMD registers of samples
+    // positionLane (optional) gives every sample its own frame position
+    void renderChunk(float* out, int numSamples, const float* positionLane = nullptr)
+    {
+        jassert(numSamples > 0 && numSamples <= renderChunkSize);
+
+        const int length = currentTable->getFrameLength(mipLevel);
+        const int mask = length - 1;
+        const int indexShift = getIndexShift();
+
+        // Frame pass: the same two frames for the whole chunk, or one pair per sample
+        ChunkFrames frames;
+        if (positionLane != nullptr)
         {
-            // Compress first half
-            warpedPhase = phaseNormalized * (1.0f / bendFactor);
+            const int lastFrame = currentTable->getNumFrames() - 1;
+            frames.perSample = true;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float frameIndexFloat = juce::jlimit(0.0f, 1.0f, positionLane[i]) * lastFrame;
+                int frame1 = static_cast<int>(frameIndexFloat);
+                frames.offset1[i] = frame1 * length;
+                frames.offset2[i] = std::min(frame1 + 1, lastFrame) * length;
+                frames.fraction[i] = frameIndexFloat - frame1;
+            }
         }
         else
         {
-            // Stretch second half to compensate
-            warpedPhase = (1.0f / bendFactor) + (phaseNormalized - 0.5f) * (1.0f - 1.0f / bendFactor) / 0.5f;
+            std::fill(frames.offset1, frames.offset1 + numSamples, morphFrame1 * length);
+            std::fill(frames.offset2, frames.offset2 + numSamples, morphFrame2 * length);
         }
 
-        // Read sample at warped phase position
-        int warpedSampleIndex = static_cast<int>(warpedPhase * Wavetable::samplesPerFrame) % Wavetable::samplesPerFrame;
+        // Phase pass: table indices and fractions at the mip level's resolution (bit fields of phase)
+        int indices[renderChunkSize];
+        alignas(32) float fractions[renderChunkSize];
+        for (int i = 0; i < numSamples; ++i)
+        {
+            indices[i] = static_cast<int>(phase >> indexShift);
+            fractions[i] = getFraction(phase, indexShift);
 
-        if (currentWavetable == nullptr)
-            return sample;
+            phase += phaseIncrement;
+            advanceRamp();
+        }
 
-        float frameIndexFloat = position * (Wavetable::numFrames - 1);
-        int frame1 = static_cast<int>(frameIndexFloat);
-        int frame2 = std::min(frame1 + 1, Wavetable::numFrames - 1);
-        float frameFrac = frameIndexFloat - frame1;
+        // Gather pass: points[k][i] is the table sample at indices[i] + k - 1
+        alignas(32) float points[maxInterpolationPoints][renderChunkSize];
+        gatherPoints(indices, mask, numSamples, frames, points);
 
-        float warpedSample1 = (*currentWavetable)[frame1][warpedSampleIndex];
-        float warpedSample2 = (*currentWavetable)[frame2][warpedSampleIndex];
-        float warpedSample = warpedSample1 + frameFrac * (warpedSample2 - warpedSample1);
+        // Pad the tail of the last SIMD register so the kernel never reads uninitialised data
+        const int paddedSize = (numSamples + numLanes - 1) / numLanes * numLanes;
+        for (int i = numSamples; i < paddedSize; ++i)
+        {
+            fractions[i] = 0.0f;
+            for (auto& point : points)
+                point[i] = 0.0f;
+        }
+
+        // Interpolation kernel: numLanes samples per instruction
+        alignas(32) float result[renderChunkSize];
+        for (int i = 0; i < paddedSize; i += numLanes)
+        {
+            Lanes f = Lanes::fromRawArray(fractions + i);
+            Lanes p1 = Lanes::fromRawArray(points[1] + i);
+            Lanes p2 = Lanes::fromRawArray(points[2] + i);
+            Lanes y;
+
+            if (interpolation == Interpolation::Linear)
+            {
+                y = interpolateLinear(p1, p2, f);
+            }
+            else
+            {
+                Lanes p0 = Lanes::fromRawArray(points[0] + i);
+                Lanes p3 = Lanes::fromRawArray(points[3] + i);
+                y = interpolation == Interpolation::Cubic ? interpolateCubic(p0, p1, p2, p3, f)
+                                                          : interpolateHermite(p0, p1, p2, p3, f);
+            }
+
+            y.copyToRawArray(result + i);
+        }
 
-        // Mix dry/wet based on warp amount
-        return sample * (1.0f - warpAmount) + warpedSample * warpAmount;
+        juce::FloatVectorOperations::copy(out, result, numSamples);
     }
 
-    float applyFM(float sample)
+    // Gather the neighbouring points the interpolation needs (wrapping within the frame)
+    // Reads the blended frame when cached, otherwise decodes and morphs both frames
+    void gatherPoints(const int* indices, int mask, int numSamples, const ChunkFrames& frames,
+                      float (&points)[maxInterpolationPoints][renderChunkSize]) const
     {
-        // FM: Frequency modulation (self-modulation)
-        // Use current sample as modulator to shift phase
-        float modDepth = warpAmount * 10.0f; // FM depth (up to 10 samples phase shift)
-        float phaseOffset = sample * modDepth * Wavetable::samplesPerFrame;
+        const int firstPoint = getFirstPoint();
+        const int lastPoint = getLastPoint();
 
-        float modulatedPhase = phase + phaseOffset;
-        while (modulatedPhase >= Wavetable::samplesPerFrame)
-            modulatedPhase -= Wavetable::samplesPerFrame;
-        while (modulatedPhase < 0.0f)
-            modulatedPhase += Wavetable::samplesPerFrame;
+        if (blendedFrame != nullptr)
+        {
+            for (int k = firstPoint; k <= lastPoint; ++k)
+                for (int i = 0; i < numSamples; ++i)
+                    points[k][i] = blendedFrame[(indices[i] + k - 1) & mask];
+            return;
+        }
 
-        int modulatedSampleIndex = static_cast<int>(modulatedPhase) % Wavetable::samplesPerFrame;
+        alignas(32) float second[renderChunkSize];
+
+        for (int k = firstPoint; k <= lastPoint; ++k)
+        {
+            // Frame 1 into points[k], frame 2 into second
+            if (currentTable->getFormat() == Wavetable::SampleFormat::Int16)
+            {
+                const int16_t* data = currentTable->getCompactFrame(mipLevel, 0);
+                int fixed[renderChunkSize];
+
+                for (int i = 0; i < numSamples; ++i)
+                    fixed[i] = data[frames.offset1[i] + ((indices[i] + k - 1) & mask)];
+                juce::FloatVectorOperations::convertFixedToFloat(points[k], fixed, currentTable->getCompactScale(), numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    fixed[i] = data[frames.offset2[i] + ((indices[i] + k - 1) & mask)];
+                juce::FloatVectorOperations::convertFixedToFloat(second, fixed, currentTable->getCompactScale(), numSamples);
+            }
+            else
+            {
+                const float* data = currentTable->getFrame(mipLevel, 0);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    points[k][i] = data[frames.offset1[i] + ((indices[i] + k - 1) & mask)];
+                    second[i] = data[frames.offset2[i] + ((indices[i] + k - 1) & mask)];
+                }
+            }
+
+            // Morph: points[k] = sample1 + frameFrac * (sample2 - sample1)
+            juce::FloatVectorOperations::subtract(second, points[k], numSamples);
+            if (frames.perSample)
+                juce::FloatVectorOperations::multiply(second, frames.fraction, numSamples);
+            else
+                juce::FloatVectorOperations::multiply(second, morphFrac, numSamples);
+            juce::FloatVectorOperations::add(points[k], second, numSamples);
+        }
+    }
+
+    // Warp settings that hold for a whole block, worked out once instead of per sample
+    struct WarpParameters
+    {
+        float dry;              // 1 - amount
+        float wet;              // amount
+        float syncRatio;        // Sync: sync oscillator increment / main increment
+        uint64_t bendScale;     // Bend+: slope of the compressed first half (Q32 fixed point)
+        uint64_t bendSlope;     // Bend+: slope of the stretched second half (Q32 fixed point)
+        float fmDepth;          // FM: phase units per unit of output
+        float crossFmDepth;     // FM (B): phase units per unit of modulator
+        uint32_t pulseWidth;    // PWM: phase where the pulse goes low
+        float pulseLevel;       // PWM: pulse height (amount / 2)
+    };
+
+    WarpParameters getWarpParameters() const
+    {
+        WarpParameters parameters;
+        parameters.dry = 1.0f - warpAmount;
+        parameters.wet = warpAmount;
+
+        // Higher warp amount = more frequent resets = more harmonics (up to 5x base frequency)
+        parameters.syncRatio = 1.0f + warpAmount * 4.0f;
+
+        // Compress the first half by up to 3x, stretch the second half to compensate
+        // Q32 slopes: the per-sample remap is an integer multiply on the phase, with no
+        // divide and no round trip through a float cycle position
+        double bendFactor = 1.0 + warpAmount * 2.0; // 1.0 to 3.0
+        double bendScale = 1.0 / bendFactor;
+        parameters.bendScale = static_cast<uint64_t>(bendScale * 4294967296.0);
+        parameters.bendSlope = static_cast<uint64_t>((1.0 - bendScale) / 0.5 * 4294967296.0);
+
+        // Up to 10 cycles of phase shift at full scale
+        parameters.fmDepth = warpAmount * 10.0f * 4294967296.0f;
+
+        // Up to 2 cycles of phase shift from a full-scale modulator (modulation index ~12.6)
+        parameters.crossFmDepth = warpAmount * 2.0f * 4294967296.0f;
+
+        // Pulse width 0.1 to 0.9
+        parameters.pulseWidth = toPhase(0.1f + warpAmount * 0.8f);
+        parameters.pulseLevel = warpAmount * 0.5f;
+        return parameters;
+    }
+
+    // Warp one sample, after the phase has advanced past it
+    template <int mode>
+    float warpSample(float sample, const WarpParameters& parameters)
+    {
+        if constexpr (mode == Sync)
+        {
+            // Hard sync: a faster sync oscillator resets the main phase when it wraps
+            // Each reset is a step in the waveform; a minBLEP residual mixed into the next
+            // samples band-limits it, instead of the naive reset's unbounded aliasing
+            sample += syncBlep.getNextCorrection();
+
+            const uint32_t previousSyncPhase = syncPhase;
+            const uint32_t syncIncrement = toPhaseUnits(static_cast<double>(phaseIncrement) * parameters.syncRatio);
+            syncPhase += syncIncrement;
+            if (syncPhase < previousSyncPhase && syncIncrement > 0) // Wrapped
+            {
+                // The wrap fell this far (0 to 1 samples) before the next sample: restart the
+                // main phase at that sub-sample point, and correct for the jump it makes there
+                const float delay = juce::jmin(1.0f, static_cast<float>(syncPhase) / static_cast<float>(syncIncrement));
+                const uint32_t sinceReset = toPhaseUnits(static_cast<double>(phaseIncrement) * delay);
+
+                const float before = readTable(phase - sinceReset); // Where the waveform was at the reset
+                const float after = readTable(0);
+                phase = sinceReset;
+
+                syncBlep.addStep(delay, after - before);
+            }
 
-        if (currentWavetable == nullptr)
             return sample;
+        }
+        else if constexpr (mode == BendPlus)
+        {
+            // Asymmetric phase distortion: compress the first half of the waveform,
+            // shifting harmonics upward, and read the table again at the warped phase
+            return sample * parameters.dry + readTable(bendPhase(phase, parameters)) * parameters.wet;
+        }
+        else if constexpr (mode == FM)
+        {
+            // Self-modulation: the output shifts the read phase (the uint32 conversion wraps it)
+            uint32_t modulatedPhase = phase + static_cast<uint32_t>(static_cast<int64_t>(sample * parameters.fmDepth));
+            return sample * parameters.dry + readTable(modulatedPhase) * parameters.wet;
+        }
+        else if constexpr (mode == AM)
+        {
+            // Self ring modulation: at 100% warp, the classic ring mod sound
+            return sample * (1.0f + sample * parameters.wet);
+        }
+        else
+        {
+            // PWM: mix in a pulse of variable width (scaled down to avoid clipping)
+            // A select between two per-block levels: no per-sample multiply for the pulse
+            return sample * parameters.dry + (phase < parameters.pulseWidth ? parameters.pulseLevel : -parameters.pulseLevel);
+        }
+    }
 
-        float frameIndexFloat = position * (Wavetable::numFrames - 1);
-        int frame1 = static_cast<int>(frameIndexFloat);
-        int frame2 = std::min(frame1 + 1, Wavetable::numFrames - 1);
-        float frameFrac = frameIndexFloat - frame1;
+    // Bend+ phase remap: the first half scaled by bendScale, the second half rising from
+    // bendScale to the end of the cycle (where the sum wraps to 0, the same point)
+    // Both halves are worked out and one selected, so the loop stays branch-free
+    static uint32_t bendPhase(uint32_t tablePhase, const WarpParameters& parameters)
+    {
+        const auto firstHalf = static_cast<uint32_t>((tablePhase * parameters.bendScale) >> 32);
+        const auto secondHalf = static_cast<uint32_t>(parameters.bendScale
+                                                      + (((tablePhase - 0x80000000u) * parameters.bendSlope) >> 32));
+        return tablePhase < 0x80000000u ? firstHalf : secondHalf;
+    }
+
+    // Per-sample warp for getNextSample()
+    float applyWarp(float sample)
+    {
+        if (warpAmount < 0.001f)
+            return sample; // No warp applied
 
-        float modulatedSample1 = (*currentWavetable)[frame1][modulatedSampleIndex];
-        float modulatedSample2 = (*currentWavetable)[frame2][modulatedSampleIndex];
-        float modulatedSample = modulatedSample1 + frameFrac * (modulatedSample2 - modulatedSample1);
+        const auto parameters = getWarpParameters();
 
-        // Mix dry/wet
-        return sample * (1.0f - warpAmount) + modulatedSample * warpAmount;
+        switch (warpMode)
+        {
+            case Sync:     return warpSample<Sync>(sample, parameters);
+            case BendPlus: return warpSample<BendPlus>(sample, parameters);
+            case FM:       return warpSample<FM>(sample, parameters);
+            case AM:       return warpSample<AM>(sample, parameters);
+            case PWM:      return warpSample<PWM>(sample, parameters);
+            default:       return sample;
+        }
     }
 
-    float applyAM(float sample)
+    // Block kernel for one warp mode: read, advance, warp - with the mode fixed at compile time
+    template <int mode>
+    void renderWarpBlock(float* out, int numSamples)
     {
-        // AM: Amplitude modulation (ring modulation effect)
-        // Modulate amplitude using oscillator's own output
-        // At 100% warp, creates classic ring mod sound
-        float modulator = sample; // Self-modulation
-        float modulated = sample * (1.0f + modulator * warpAmount);
+        const auto parameters = getWarpParameters();
 
-        return modulated;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float sample = readTable(phase);
+
+            phase += phaseIncrement;
+            advanceRamp();
+
+            out[i] = warpSample<mode>(sample, parameters);
+        }
     }
 
-    float applyPWM(float sample)
+    // Block kernel for the cross-modulation modes, reading the modulator block sample by sample
+    template <int mode>
+    void renderCrossModBlock(float* out, int numSamples)
     {
-        // PWM: Pulse width modulation
-        // Creates pulse-wave like effect by thresholding with variable width
-        float phaseNormalized = phase / Wavetable::samplesPerFrame; // 0.0 to 1.0
+        const auto parameters = getWarpParameters();
+        const float* modulator = crossModulator;
 
-        // Pulse width controlled by warp amount (0.1 to 0.9)
-        float pulseWidth = 0.1f + warpAmount * 0.8f;
+        if (modulator == nullptr)
+        {
+            // No modulator (e.g. osc B itself, or the per-sample path): render unmodulated
+            for (int start = 0; start < numSamples; start += renderChunkSize)
+                renderChunk(out + start, juce::jmin(renderChunkSize, numSamples - start));
+            return;
+        }
 
-        // Create pulse wave
-        float pulseWave = (phaseNormalized < pulseWidth) ? 1.0f : -1.0f;
+        if constexpr (mode == FMFromB)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                // Signed offset: the uint32 conversion wraps negative shifts backwards through zero
+                const auto offset = static_cast<uint32_t>(static_cast<int64_t>(modulator[i] * parameters.crossFmDepth));
+                out[i] = readTable(phase + offset);
+
+                phase += phaseIncrement;
+                advanceRamp();
+            }
+        }
+        else
+        {
+            // Render the carrier with the vectorized chunk path, then ring modulate the block:
+            // out *= dry + wet * modulator
+            for (int start = 0; start < numSamples; start += renderChunkSize)
+                renderChunk(out + start, juce::jmin(renderChunkSize, numSamples - start));
 
-        // Mix with original sample based on warp amount
-        return sample * (1.0f - warpAmount) + pulseWave * warpAmount * 0.5f; // Scale down pulse to avoid clipping
+            for (int i = 0; i < numSamples; ++i)
+                out[i] *= parameters.dry + parameters.wet * modulator[i];
+        }
     }
 
-    // Helper to get sample rate (needed for sync mode)
-    double getSampleRate() const
+    using WarpRenderer = void (WavetableOscillator::*)(float*, int);
+
+    static WarpRenderer getWarpRenderer(int mode)
     {
-        // Calculate from phase increment and frequency
-        // phaseIncrement = (frequency / sampleRate) * samplesPerFrame
-        // Therefore: sampleRate = (frequency * samplesPerFrame) / phaseIncrement
-        if (phaseIncrement > 0.0f)
-            return (frequency * Wavetable::samplesPerFrame) / phaseIncrement;
-        return 44100.0; // Fallback
+        switch (mode)
+        {
+            case BendPlus: return &WavetableOscillator::renderWarpBlock<BendPlus>;
+            case FM:       return &WavetableOscillator::renderWarpBlock<FM>;
+            case AM:       return &WavetableOscillator::renderWarpBlock<AM>;
+            case PWM:      return &WavetableOscillator::renderWarpBlock<PWM>;
+            case FMFromB:  return &WavetableOscillator::renderCrossModBlock<FMFromB>;
+            case RMFromB:  return &WavetableOscillator::renderCrossModBlock<RMFromB>;
+            default:       return &WavetableOscillator::renderWarpBlock<Sync>;
+        }
     }
+
 };